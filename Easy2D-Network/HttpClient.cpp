@@ -232,6 +232,8 @@ namespace easy2d
 					request_queue_.pop();
 				}
 
+				E2D_PROFILE_SCOPE("HttpClient::NetworkThread");
+
 				HttpResponsePtr response = new (std::nothrow) HttpResponse(request);
 				Perform(request, response);
 
@@ -19,6 +19,8 @@
 // THE SOFTWARE.
 
 #include "Action.h"
+#include "ActionTween.h"
+#include "TweenSystem.h"
 #include "Node.h"
 
 namespace easy2d
@@ -26,6 +28,8 @@ namespace easy2d
 	Action::Action()
 		: running_(true)
 		, detach_target_(false)
+		, batchable_(false)
+		, batched_(false)
 		, loops_done_(0)
 		, loops_(0)
 		, status_(Status::NotStarted)
@@ -62,13 +66,7 @@ namespace easy2d
 
 		if (status_ == Status::Done)
 		{
-			if (cb_done_)
-				cb_done_();
-
-			if (detach_target_)
-				target->RemoveFromParent();
-
-			status_ = Status::Removeable;
+			Finish(target);
 		}
 	}
 
@@ -90,8 +88,27 @@ namespace easy2d
 		++loops_done_;
 	}
 
+	void Action::Finish(NodePtr const& target)
+	{
+		if (cb_done_)
+			cb_done_();
+
+		if (detach_target_)
+			target->RemoveFromParent();
+
+		status_ = Status::Removeable;
+	}
+
 	void Action::Restart(NodePtr const & target)
 	{
+		// the tween system keeps its own copy of the timing and start values,
+		// hand the tween back so it is added again from the fresh state
+		if (batched_)
+		{
+			ActionTween* tween = static_cast<ActionTween*>(this);
+			tween->GetTweenSystem()->Remove(tween);
+		}
+
 		status_ = Status::NotStarted;
 		elapsed_ = 0;
 		loops_done_ = 0;
@@ -29,11 +29,11 @@ namespace easy2d
 
 	class Action
 		: public virtual Object
-		, protected IntrusiveListItem<ActionPtr>
+		, protected IntrusiveRawListItem<Action>
 	{
 		friend class ActionManager;
 		friend class ActionGroup;
-		friend class IntrusiveList<ActionPtr>;
+		friend class IntrusiveRawList<Action>;
 
 	public:
 		enum class Status
@@ -108,12 +108,16 @@ namespace easy2d
 
 		void Complete(NodePtr const& target);
 
+		void Finish(NodePtr const& target);
+
 		void Restart(NodePtr const& target);
 
 	protected:
 		Status			status_;
 		bool			running_;
 		bool			detach_target_;
+		bool			batchable_;		// Խɲϵͳ
+		bool			batched_;		// ɲϵͳ
 		int				loops_;
 		int				loops_done_;
 		Duration		delay_;
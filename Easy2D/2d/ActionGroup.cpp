@@ -105,7 +105,7 @@ namespace easy2d
 	{
 		if (action)
 		{
-			actions_.PushBack(action);
+			actions_.PushBack(action.Get());
 		}
 	}
 
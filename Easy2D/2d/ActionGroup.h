@@ -28,7 +28,7 @@ namespace easy2d
 		: public Action
 	{
 	public:
-		using ActionList = IntrusiveList<ActionPtr>;
+		using ActionList = IntrusiveRawList<Action>;
 
 		ActionGroup();
 
@@ -200,7 +200,7 @@ namespace easy2d
 		static inline TweenHelper
 			Animation(FramesPtr const& frames)
 		{
-			return TweenHelper(new easy2d::Animation(0, frames));
+			return TweenHelper(new easy2d::Animation(frames));
 		}
 
 		static inline ActionHelper
@@ -19,25 +19,66 @@
 // THE SOFTWARE.
 
 #include "ActionManager.h"
+#include "ActionTween.h"
+#include "Scene.h"
 #include "../base/logs.h"
+#include "../base/Trace.h"
 
 namespace easy2d
 {
 	void ActionManager::UpdateActions(NodePtr const& target, Duration dt)
 	{
+		E2D_PROFILE_SCOPE("ActionManager::UpdateActions");
+
 		if (actions_.IsEmpty() || !target)
 			return;
 
-		ActionPtr next;
-		for (auto action = actions_.First(); action; action = next)
+		for (Actions::Iterator iter(actions_); iter; iter.Next())
 		{
-			next = action->NextItem();
+			Action* action = iter.Get();
 
 			if (action->IsRunning())
-				action->UpdateStep(target, dt);
+			{
+				if (action->batched_)
+				{
+					// stepped by the tween system of the scene
+					action->elapsed_ += dt;
+
+					ActionTween* tween = static_cast<ActionTween*>(action);
+					tween->GetTweenSystem()->MarkActive(tween);
+				}
+				else
+				{
+					action->UpdateStep(target, dt);
+
+					if (action->batchable_ && action->GetStatus() == Action::Status::Started && target->GetScene())
+					{
+						target->GetScene()->GetTweenSystem().Add(static_cast<ActionTween*>(action), target.Get());
+					}
+				}
+			}
 
 			if (action->IsRemoveable())
+			{
+				if (action->batched_)
+				{
+					ActionTween* tween = static_cast<ActionTween*>(action);
+					tween->GetTweenSystem()->Remove(tween);
+				}
 				actions_.Remove(action);
+			}
+		}
+	}
+
+	void ActionManager::DetachTweens()
+	{
+		for (auto action = actions_.First(); action; action = action->NextItem())
+		{
+			if (action->batched_)
+			{
+				ActionTween* tween = static_cast<ActionTween*>(action);
+				tween->GetTweenSystem()->Remove(tween);
+			}
 		}
 	}
 
@@ -47,7 +88,7 @@ namespace easy2d
 
 		if (action)
 		{
-			actions_.PushBack(action);
+			actions_.PushBack(action.Get());
 		}
 		return action;
 	}
@@ -57,7 +98,7 @@ namespace easy2d
 		if (actions_.IsEmpty())
 			return nullptr;
 
-		for (auto action = actions_.First().Get(); action; action = action->NextItem().Get())
+		for (auto action = actions_.First(); action; action = action->NextItem())
 			if (action->IsName(name))
 				return action;
 		return nullptr;
@@ -68,7 +109,7 @@ namespace easy2d
 		if (actions_.IsEmpty())
 			return;
 
-		for (auto action = actions_.First().Get(); action; action = action->NextItem().Get())
+		for (auto action = actions_.First(); action; action = action->NextItem())
 		{
 			action->Resume();
 		}
@@ -79,7 +120,7 @@ namespace easy2d
 		if (actions_.IsEmpty())
 			return;
 
-		for (auto action = actions_.First().Get(); action; action = action->NextItem().Get())
+		for (auto action = actions_.First(); action; action = action->NextItem())
 		{
 			action->Pause();
 		}
@@ -90,7 +131,7 @@ namespace easy2d
 		if (actions_.IsEmpty())
 			return;
 
-		for (auto action = actions_.First().Get(); action; action = action->NextItem().Get())
+		for (auto action = actions_.First(); action; action = action->NextItem())
 		{
 			action->Stop();
 		}
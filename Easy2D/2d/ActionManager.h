@@ -25,7 +25,7 @@ namespace easy2d
 {
 	class E2D_API ActionManager
 	{
-		using Actions = IntrusiveList<ActionPtr>;
+		using Actions = IntrusiveRawList<Action>;
 
 	public:
 		// Ӷ
@@ -53,6 +53,9 @@ namespace easy2d
 	protected:
 		void UpdateActions(NodePtr const& target, Duration dt);
 
+		// µĲ䶯ӲϵͳƳ, ڵ뿪ʱ
+		void DetachTweens();
+
 	protected:
 		Actions actions_;
 	};
@@ -21,6 +21,10 @@
 #include "ActionTween.h"
 #include "include-forwards.h"
 #include "Node.h"
+#include "TweenSystem.h"
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace easy2d
 {
@@ -28,37 +32,105 @@ namespace easy2d
 	// Ease Functions
 	//-------------------------------------------------------
 
-	EaseFunc Ease::Linear = math::Linear;
+	namespace
+	{
+		// tables of built-in curves are shared by all tweens using the same curve
+		typedef std::tuple<EaseType, float, int> EaseTableKey;
+
+		std::mutex ease_tables_mutex;
+		std::map<EaseTableKey, std::shared_ptr<const Array<float>>> ease_tables;
+	}
+
+	EaseFunc Ease::Linear = EaseType::Linear;
 	EaseFunc Ease::EaseIn = MakeEaseIn(2.f);
 	EaseFunc Ease::EaseOut = MakeEaseOut(2.f);
 	EaseFunc Ease::EaseInOut = MakeEaseInOut(2.f);
-	EaseFunc Ease::ExpoIn = math::EaseExponentialIn;
-	EaseFunc Ease::ExpoOut = math::EaseExponentialOut;
-	EaseFunc Ease::ExpoInOut = math::EaseExponentialInOut;
-	EaseFunc Ease::BounceIn = math::EaseBounceIn;
-	EaseFunc Ease::BounceOut = math::EaseBounceOut;
-	EaseFunc Ease::BounceInOut = math::EaseBounceInOut;
+	EaseFunc Ease::ExpoIn = EaseType::ExpoIn;
+	EaseFunc Ease::ExpoOut = EaseType::ExpoOut;
+	EaseFunc Ease::ExpoInOut = EaseType::ExpoInOut;
+	EaseFunc Ease::BounceIn = EaseType::BounceIn;
+	EaseFunc Ease::BounceOut = EaseType::BounceOut;
+	EaseFunc Ease::BounceInOut = EaseType::BounceInOut;
 	EaseFunc Ease::ElasticIn = MakeEaseElasticIn(0.3f);
 	EaseFunc Ease::ElasticOut = MakeEaseElasticOut(0.3f);
 	EaseFunc Ease::ElasticInOut = MakeEaseElasticInOut(0.3f);
-	EaseFunc Ease::SineIn = math::EaseSineIn;
-	EaseFunc Ease::SineOut = math::EaseSineOut;
-	EaseFunc Ease::SineInOut = math::EaseSineInOut;
-	EaseFunc Ease::BackIn = math::EaseBackIn;
-	EaseFunc Ease::BackOut = math::EaseBackOut;
-	EaseFunc Ease::BackInOut = math::EaseBackInOut;
-	EaseFunc Ease::QuadIn = math::EaseQuadIn;
-	EaseFunc Ease::QuadOut = math::EaseQuadOut;
-	EaseFunc Ease::QuadInOut = math::EaseQuadInOut;
-	EaseFunc Ease::CubicIn = math::EaseCubicIn;
-	EaseFunc Ease::CubicOut = math::EaseCubicOut;
-	EaseFunc Ease::CubicInOut = math::EaseCubicInOut;
-	EaseFunc Ease::QuartIn = math::EaseQuartIn;
-	EaseFunc Ease::QuartOut = math::EaseQuartOut;
-	EaseFunc Ease::QuartInOut = math::EaseQuartInOut;
-	EaseFunc Ease::QuintIn = math::EaseQuintIn;
-	EaseFunc Ease::QuintOut = math::EaseQuintOut;
-	EaseFunc Ease::QuintInOut = math::EaseQuintInOut;
+	EaseFunc Ease::SineIn = EaseType::SineIn;
+	EaseFunc Ease::SineOut = EaseType::SineOut;
+	EaseFunc Ease::SineInOut = EaseType::SineInOut;
+	EaseFunc Ease::BackIn = EaseType::BackIn;
+	EaseFunc Ease::BackOut = EaseType::BackOut;
+	EaseFunc Ease::BackInOut = EaseType::BackInOut;
+	EaseFunc Ease::QuadIn = EaseType::QuadIn;
+	EaseFunc Ease::QuadOut = EaseType::QuadOut;
+	EaseFunc Ease::QuadInOut = EaseType::QuadInOut;
+	EaseFunc Ease::CubicIn = EaseType::CubicIn;
+	EaseFunc Ease::CubicOut = EaseType::CubicOut;
+	EaseFunc Ease::CubicInOut = EaseType::CubicInOut;
+	EaseFunc Ease::QuartIn = EaseType::QuartIn;
+	EaseFunc Ease::QuartOut = EaseType::QuartOut;
+	EaseFunc Ease::QuartInOut = EaseType::QuartInOut;
+	EaseFunc Ease::QuintIn = EaseType::QuintIn;
+	EaseFunc Ease::QuintOut = EaseType::QuintOut;
+	EaseFunc Ease::QuintInOut = EaseType::QuintInOut;
+
+	EaseFunc::EaseFunc()
+		: type_(EaseType::None)
+		, param_(0.f)
+	{
+	}
+
+	EaseFunc::EaseFunc(std::nullptr_t)
+		: type_(EaseType::None)
+		, param_(0.f)
+	{
+	}
+
+	EaseFunc::EaseFunc(EaseType type, float param)
+		: type_(type)
+		, param_(param)
+	{
+		E2D_ASSERT(type != EaseType::Table && type != EaseType::Custom);
+	}
+
+	EaseFunc EaseFunc::ToTable(int samples) const
+	{
+		if (!(*this) || type_ == EaseType::Table)
+			return *this;
+
+		samples = std::max(samples, 2);
+
+		EaseFunc func;
+		func.type_ = EaseType::Table;
+
+		const EaseTableKey key(type_, param_, samples);
+		if (type_ != EaseType::Custom)
+		{
+			std::lock_guard<std::mutex> lock(ease_tables_mutex);
+			auto iter = ease_tables.find(key);
+			if (iter != ease_tables.end())
+			{
+				func.table_ = iter->second;
+				return func;
+			}
+		}
+
+		auto table = std::make_shared<Array<float>>();
+		table->resize(static_cast<size_t>(samples));
+
+		float* data = table->begin();
+		for (int i = 0; i < samples; ++i)
+		{
+			data[i] = (*this)(static_cast<float>(i) / (samples - 1));
+		}
+		func.table_ = table;
+
+		if (type_ != EaseType::Custom)
+		{
+			std::lock_guard<std::mutex> lock(ease_tables_mutex);
+			ease_tables[key] = func.table_;
+		}
+		return func;
+	}
 
 	//-------------------------------------------------------
 	// ActionTween
@@ -67,10 +139,16 @@ namespace easy2d
 	ActionTween::ActionTween()
 		: dur_()
 		, ease_func_(nullptr)
+		, property_(TweenProperty::None)
+		, tween_system_(nullptr)
+		, tween_slot_(-1)
 	{
 	}
 
 	ActionTween::ActionTween(Duration duration, EaseFunc func)
+		: property_(TweenProperty::None)
+		, tween_system_(nullptr)
+		, tween_slot_(-1)
 	{
 		SetDuration(duration);
 		SetEaseFunc(func);
@@ -79,6 +157,9 @@ namespace easy2d
 	void ActionTween::SetEaseFunc(EaseFunc const& func)
 	{
 		ease_func_ = func;
+
+		if (tween_system_)
+			tween_system_->UpdateEase(this);
 	}
 
 	EaseFunc const & ActionTween::GetEaseFunc() const
@@ -124,6 +205,12 @@ namespace easy2d
 		dur_ = duration;
 	}
 
+	void ActionTween::EnableBatching(TweenProperty property)
+	{
+		property_ = property;
+		batchable_ = true;
+	}
+
 
 	//-------------------------------------------------------
 	// Move Action
@@ -133,6 +220,7 @@ namespace easy2d
 		: ActionTween(duration, func)
 	{
 		delta_pos_ = vector;
+		EnableBatching(TweenProperty::Position);
 	}
 
 	void ActionMoveBy::Init(NodePtr const& target)
@@ -154,6 +242,19 @@ namespace easy2d
 		prev_pos_ = new_pos;
 	}
 
+	void ActionMoveBy::SaveTweenState(TweenState& state) const
+	{
+		state.start = start_pos_;
+		state.delta = delta_pos_;
+		state.prev = prev_pos_;
+	}
+
+	void ActionMoveBy::LoadTweenState(TweenState const& state)
+	{
+		start_pos_ = state.start;
+		prev_pos_ = state.prev;
+	}
+
 	ActionPtr ActionMoveBy::Clone() const
 	{
 		return new (std::nothrow) ActionMoveBy(dur_, delta_pos_, ease_func_);
@@ -255,6 +356,7 @@ namespace easy2d
 	{
 		delta_x_ = scale;
 		delta_y_ = scale;
+		EnableBatching(TweenProperty::Scale);
 	}
 
 	ActionScaleBy::ActionScaleBy(Duration duration, float scale_x, float scale_y, EaseFunc func)
@@ -262,6 +364,7 @@ namespace easy2d
 	{
 		delta_x_ = scale_x;
 		delta_y_ = scale_y;
+		EnableBatching(TweenProperty::Scale);
 	}
 
 	void ActionScaleBy::Init(NodePtr const& target)
@@ -278,6 +381,18 @@ namespace easy2d
 		target->SetScale(start_scale_x_ + delta_x_ * percent, start_scale_y_ + delta_y_ * percent);
 	}
 
+	void ActionScaleBy::SaveTweenState(TweenState& state) const
+	{
+		state.start = Point(start_scale_x_, start_scale_y_);
+		state.delta = Point(delta_x_, delta_y_);
+	}
+
+	void ActionScaleBy::LoadTweenState(TweenState const& state)
+	{
+		start_scale_x_ = state.start.x;
+		start_scale_y_ = state.start.y;
+	}
+
 	ActionPtr ActionScaleBy::Clone() const
 	{
 		return new (std::nothrow) ActionScaleBy(dur_, delta_x_, delta_y_, ease_func_);
@@ -323,6 +438,7 @@ namespace easy2d
 		: ActionTween(duration, func)
 	{
 		delta_val_ = opacity;
+		EnableBatching(TweenProperty::Opacity);
 	}
 
 	void ActionOpacityBy::Init(NodePtr const& target)
@@ -338,6 +454,17 @@ namespace easy2d
 		target->SetOpacity(start_val_ + delta_val_ * percent);
 	}
 
+	void ActionOpacityBy::SaveTweenState(TweenState& state) const
+	{
+		state.start = Point(start_val_, 0.f);
+		state.delta = Point(delta_val_, 0.f);
+	}
+
+	void ActionOpacityBy::LoadTweenState(TweenState const& state)
+	{
+		start_val_ = state.start.x;
+	}
+
 	ActionPtr ActionOpacityBy::Clone() const
 	{
 		return new (std::nothrow) ActionOpacityBy(dur_, delta_val_, ease_func_);
@@ -384,6 +511,7 @@ namespace easy2d
 		: ActionTween(duration, func)
 		, delta_val_(rotation)
 	{
+		EnableBatching(TweenProperty::Rotation);
 	}
 
 	void ActionRotateBy::Init(NodePtr const& target)
@@ -403,6 +531,17 @@ namespace easy2d
 		target->SetRotation(rotation);
 	}
 
+	void ActionRotateBy::SaveTweenState(TweenState& state) const
+	{
+		state.start = Point(start_val_, 0.f);
+		state.delta = Point(delta_val_, 0.f);
+	}
+
+	void ActionRotateBy::LoadTweenState(TweenState const& state)
+	{
+		start_val_ = state.start.x;
+	}
+
 	ActionPtr ActionRotateBy::Clone() const
 	{
 		return new (std::nothrow) ActionRotateBy(dur_, delta_val_, ease_func_);
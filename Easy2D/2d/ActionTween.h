@@ -25,11 +25,159 @@
 
 namespace easy2d
 {
+	// 
+	// See https://easings.net for more information
+	enum class EaseType
+	{
+		None,			// ʹû
+		Linear,			// 
+		EaseIn,			// , Ϊ
+		EaseOut,		// ɿ, Ϊ
+		EaseInOut,		// , ɿ, Ϊ
+		ExpoIn,			// 伫
+		ExpoOut,		// ɼ
+		ExpoInOut,		// , ɼ
+		ElasticIn,		// 㸳赯, Ϊ
+		ElasticOut,		// յ㸳赯, Ϊ
+		ElasticInOut,	// յ㸳赯, Ϊ
+		BounceIn,		// 㸳跴
+		BounceOut,		// յ㸳跴
+		BounceInOut,	// յ㸳跴
+		BackIn,
+		BackOut,
+		BackInOut,
+		QuadIn,
+		QuadOut,
+		QuadInOut,
+		CubicIn,
+		CubicOut,
+		CubicInOut,
+		QuartIn,
+		QuartOut,
+		QuartInOut,
+		QuintIn,
+		QuintOut,
+		QuintInOut,
+		SineIn,
+		SineOut,
+		SineInOut,
+		Table,			// ұ
+		Custom			// Զ庯
+	};
+
+
 	// 
-	using EaseFunc = std::function<float(float)>;
+	// ߱ΪͺͲ, ͨ switch ַ, Ա
+	// ɵöΪԶ߱ std::function 
+	class E2D_API EaseFunc
+	{
+	public:
+		EaseFunc();
+
+		EaseFunc(std::nullptr_t);
+
+		EaseFunc(
+			EaseType type,
+			float param = 0.f
+		);
+
+		template <typename _Func>
+		EaseFunc(_Func const& func)
+			: type_(EaseType::Custom)
+			, param_(0.f)
+			, custom_(func)
+		{
+			if (!custom_)
+				type_ = EaseType::None;
+		}
+
+		inline EaseType GetType() const				{ return type_; }
+
+		inline float GetParam() const				{ return param_; }
+
+		inline explicit operator bool() const		{ return type_ != EaseType::None; }
+
+		inline float operator()(float step) const
+		{
+			switch (type_)
+			{
+			case EaseType::Table:	return SampleTable(table_->begin(), table_->size(), step);
+			case EaseType::Custom:	return custom_(step);
+			default:				return Evaluate(type_, param_, step);
+			}
+		}
+
+		// ȡұ, ǲұʱؿ
+		inline Array<float> const* GetTable() const	{ return table_.get(); }
+
+		// ɲұ, ڼϴ (絯, ָ)
+		// ֮Բֵ, ͬ߹ͬһŲұ
+		EaseFunc ToTable(
+			int samples = 256
+		) const;
+
+		// 
+		static inline float Evaluate(EaseType type, float param, float step)
+		{
+			switch (type)
+			{
+			case EaseType::Linear:			return math::Linear(step);
+			case EaseType::EaseIn:			return math::EaseIn(step, param);
+			case EaseType::EaseOut:			return math::EaseOut(step, param);
+			case EaseType::EaseInOut:		return math::EaseInOut(step, param);
+			case EaseType::ExpoIn:			return math::EaseExponentialIn(step);
+			case EaseType::ExpoOut:			return math::EaseExponentialOut(step);
+			case EaseType::ExpoInOut:		return math::EaseExponentialInOut(step);
+			case EaseType::ElasticIn:		return math::EaseElasticIn(step, param);
+			case EaseType::ElasticOut:		return math::EaseElasticOut(step, param);
+			case EaseType::ElasticInOut:	return math::EaseElasticInOut(step, param);
+			case EaseType::BounceIn:		return math::EaseBounceIn(step);
+			case EaseType::BounceOut:		return math::EaseBounceOut(step);
+			case EaseType::BounceInOut:		return math::EaseBounceInOut(step);
+			case EaseType::BackIn:			return math::EaseBackIn(step);
+			case EaseType::BackOut:			return math::EaseBackOut(step);
+			case EaseType::BackInOut:		return math::EaseBackInOut(step);
+			case EaseType::QuadIn:			return math::EaseQuadIn(step);
+			case EaseType::QuadOut:			return math::EaseQuadOut(step);
+			case EaseType::QuadInOut:		return math::EaseQuadInOut(step);
+			case EaseType::CubicIn:			return math::EaseCubicIn(step);
+			case EaseType::CubicOut:		return math::EaseCubicOut(step);
+			case EaseType::CubicInOut:		return math::EaseCubicInOut(step);
+			case EaseType::QuartIn:			return math::EaseQuartIn(step);
+			case EaseType::QuartOut:		return math::EaseQuartOut(step);
+			case EaseType::QuartInOut:		return math::EaseQuartInOut(step);
+			case EaseType::QuintIn:			return math::EaseQuintIn(step);
+			case EaseType::QuintOut:		return math::EaseQuintOut(step);
+			case EaseType::QuintInOut:		return math::EaseQuintInOut(step);
+			case EaseType::SineIn:			return math::EaseSineIn(step);
+			case EaseType::SineOut:			return math::EaseSineOut(step);
+			case EaseType::SineInOut:		return math::EaseSineInOut(step);
+			default:						return step;
+			}
+		}
+
+		// ڲұв
+		static inline float SampleTable(const float* table, size_t size, float step)
+		{
+			const size_t last = size - 1;
+
+			const float pos = std::min(std::max(step, 0.f), 1.f) * static_cast<float>(last);
+			const size_t index = static_cast<size_t>(pos);
+			if (index >= last)
+				return table[last];
+
+			return table[index] + (table[index + 1] - table[index]) * (pos - static_cast<float>(index));
+		}
+
+	private:
+		EaseType							type_;
+		float								param_;
+		std::shared_ptr<const Array<float>>	table_;
+		std::function<float(float)>			custom_;
+	};
+
 
 	// ö
-	// See https://easings.net for more information
 	struct Ease
 	{
 		static E2D_API EaseFunc Linear;			// 
@@ -65,18 +213,44 @@ namespace easy2d
 		static E2D_API EaseFunc SineInOut;
 	};
 
-	inline EaseFunc MakeEaseIn(float rate) { return std::bind(math::EaseIn, std::placeholders::_1, rate); }
-	inline EaseFunc MakeEaseOut(float rate) { return std::bind(math::EaseOut, std::placeholders::_1, rate); }
-	inline EaseFunc MakeEaseInOut(float rate) { return std::bind(math::EaseInOut, std::placeholders::_1, rate); }
-	inline EaseFunc MakeEaseElasticIn(float period) { return std::bind(math::EaseElasticIn, std::placeholders::_1, period); }
-	inline EaseFunc MakeEaseElasticOut(float period) { return std::bind(math::EaseElasticOut, std::placeholders::_1, period); }
-	inline EaseFunc MakeEaseElasticInOut(float period) { return std::bind(math::EaseElasticInOut, std::placeholders::_1, period); }
+	inline EaseFunc MakeEaseIn(float rate) { return EaseFunc(EaseType::EaseIn, rate); }
+	inline EaseFunc MakeEaseOut(float rate) { return EaseFunc(EaseType::EaseOut, rate); }
+	inline EaseFunc MakeEaseInOut(float rate) { return EaseFunc(EaseType::EaseInOut, rate); }
+	inline EaseFunc MakeEaseElasticIn(float period) { return EaseFunc(EaseType::ElasticIn, period); }
+	inline EaseFunc MakeEaseElasticOut(float period) { return EaseFunc(EaseType::ElasticOut, period); }
+	inline EaseFunc MakeEaseElasticInOut(float period) { return EaseFunc(EaseType::ElasticInOut, period); }
+
+
+	class TweenSystem;
+
+	// ɲϵͳµ
+	enum class TweenProperty
+	{
+		None = -1,
+		Position,
+		Scale,
+		Rotation,
+		Opacity,
+
+		Count
+	};
+
+	// ϵͳбĶ״̬, ת͸ֻʹ x 
+	struct TweenState
+	{
+		Point start;	// ʼֵ
+		Point delta;	// 仯
+		Point prev;		// һдλ, ڵⲿλõ޸
+	};
 
 
 	// 䶯
+	// ֱӵڵϵλ, , ת͸ȶڿʼɳĲϵͳ
 	class E2D_API ActionTween
 		: public Action
 	{
+		friend class TweenSystem;
+
 	public:
 		ActionTween();
 
@@ -96,14 +270,32 @@ namespace easy2d
 
 		void SetDuration(Duration duration);
 
+		// ȡµ
+		inline TweenProperty GetTweenProperty() const	{ return property_; }
+
+		// ȡڸ¸öĲϵͳ
+		inline TweenSystem* GetTweenSystem() const		{ return tween_system_; }
+
 	protected:
 		void Update(NodePtr const& target, Duration dt) override;
 
 		virtual void UpdateTween(NodePtr const& target, float percent) = 0;
 
+		// ɲϵͳ
+		void EnableBatching(TweenProperty property);
+
+		// ״̬ϵͳ
+		virtual void SaveTweenState(TweenState&) const {}
+
+		// Ӳϵͳȡ״̬
+		virtual void LoadTweenState(TweenState const&) {}
+
 	protected:
-		Duration dur_;
-		EaseFunc ease_func_;
+		Duration		dur_;
+		EaseFunc		ease_func_;
+		TweenProperty	property_;
+		TweenSystem*	tween_system_;
+		int				tween_slot_;
 	};
 
 
@@ -129,6 +321,10 @@ namespace easy2d
 
 		void UpdateTween(NodePtr const& target, float percent) override;
 
+		void SaveTweenState(TweenState& state) const override;
+
+		void LoadTweenState(TweenState const& state) override;
+
 	protected:
 		Point	start_pos_;
 		Point	prev_pos_;
@@ -258,6 +454,10 @@ namespace easy2d
 
 		void UpdateTween(NodePtr const& target, float percent) override;
 
+		void SaveTweenState(TweenState& state) const override;
+
+		void LoadTweenState(TweenState const& state) override;
+
 	protected:
 		float	start_scale_x_;
 		float	start_scale_y_;
@@ -325,6 +525,10 @@ namespace easy2d
 
 		void UpdateTween(NodePtr const& target, float percent) override;
 
+		void SaveTweenState(TweenState& state) const override;
+
+		void LoadTweenState(TweenState const& state) override;
+
 	protected:
 		float start_val_;
 		float delta_val_;
@@ -408,6 +612,10 @@ namespace easy2d
 
 		void UpdateTween(NodePtr const& target, float percent) override;
 
+		void SaveTweenState(TweenState& state) const override;
+
+		void LoadTweenState(TweenState const& state) override;
+
 	protected:
 		float start_val_;
 		float delta_val_;
@@ -27,16 +27,25 @@ namespace easy2d
 {
 	Animation::Animation()
 		: frames_(nullptr)
+		, sprite_(nullptr)
+		, frame_index_(-1)
 	{
 	}
 
 	Animation::Animation(Duration duration, FramesPtr const& animation, EaseFunc func)
 		: ActionTween(duration, func)
 		, frames_(nullptr)
+		, sprite_(nullptr)
+		, frame_index_(-1)
 	{
 		this->SetFrames(animation);
 	}
 
+	Animation::Animation(FramesPtr const& animation, EaseFunc func)
+		: Animation(animation ? animation->GetDuration() : Duration(), animation, func)
+	{
+	}
+
 	Animation::~Animation()
 	{
 	}
@@ -49,34 +58,88 @@ namespace easy2d
 	void Animation::SetFrames(FramesPtr const& frames)
 	{
 		frames_ = frames;
+		sheet_image_ = nullptr;
+		frame_index_ = -1;
 	}
 
 	void Animation::Init(NodePtr const& target)
 	{
-		if (!frames_ || frames_->GetFrames().empty())
+		if (!frames_ || frames_->GetFrameCount() == 0)
+		{
+			Done();
+			return;
+		}
+
+		// equal-length frames give no duration of their own, see Animation(FramesPtr const&, EaseFunc)
+		E2D_ASSERT(!GetDuration().IsZero() && "Animation has no duration, set one or give the frames durations");
+
+		// resolved once per loop instead of every tick
+		sprite_ = dynamic_cast<Sprite*>(target.Get());
+
+		E2D_ASSERT(sprite_ && "Animation only supports Sprites");
+		if (!sprite_)
 		{
 			Done();
 			return;
 		}
 
-		auto sprite_target = dynamic_cast<Sprite*>(target.Get());
-		if (sprite_target && frames_)
+		// a fresh start always applies the first frame, the target may have been changed meanwhile
+		if (status_ == Status::NotStarted)
+			frame_index_ = -1;
+
+		if (frames_->IsSheet())
 		{
-			sprite_target->Load(frames_->GetFrames()[0]);
+			// give the sprite its own image over the sheet bitmap so cropping never touches shared images
+			if (!sheet_image_)
+			{
+				sheet_image_ = new (std::nothrow) Image(frames_->GetSheet()->GetBitmap());
+			}
+
+			if (sheet_image_ && sprite_->GetImage() != sheet_image_)
+			{
+				sprite_->Load(sheet_image_);
+				frame_index_ = -1;
+			}
 		}
+
+		ShowFrame(0);
 	}
 
 	void Animation::UpdateTween(NodePtr const& target, float percent)
 	{
-		auto sprite_target = dynamic_cast<Sprite*>(target.Get());
+		ShowFrame(frames_->FindFrame(percent));
+	}
 
-		E2D_ASSERT(sprite_target && "Animation only supports Sprites");
+	void Animation::ShowFrame(int index)
+	{
+		if (index == frame_index_ || index < 0 || !sprite_)
+			return;
 
-		const auto& frames = frames_->GetFrames();
-		int size = frames.size();
-		int index = std::min(static_cast<int>(math::Floor(size * percent)), size - 1);
+		if (frames_->IsSheet())
+		{
+			if (sheet_image_)
+			{
+				sprite_->Crop(frames_->GetCropRects().begin()[index]);
+			}
+		}
+		else
+		{
+			sprite_->Load(frames_->GetFrames().begin()[index]);
+		}
 
-		sprite_target->Load(frames[index]);
+		const int last_index = frame_index_;
+		frame_index_ = index;
+
+		if (frames_->HasEvents())
+		{
+			// fire the events of frames skipped by a large step as well
+			int first = (index > last_index) ? last_index + 1 : index;
+			for (int i = first; i <= index; ++i)
+			{
+				if (auto cb = frames_->GetEvent(i))
+					(*cb)();
+			}
+		}
 	}
 
 	ActionPtr Animation::Clone() const
@@ -101,4 +164,4 @@ namespace easy2d
 		return nullptr;
 	}
 
-}
\ No newline at end of file
+}
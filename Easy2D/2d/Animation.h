@@ -20,6 +20,7 @@
 
 #pragma once
 #include "ActionTween.h"
+#include "Frames.h"
 
 namespace easy2d
 {
@@ -36,6 +37,13 @@ namespace easy2d
 			EaseFunc func = nullptr		/* ٶȱ仯 */
 		);
 
+		// ʹø֡ʱ֮Ϊʱ
+		// ֡ʱΪ 0 (ȳ֡) ʱʱΪ 0, Ҫڿʼǰ SetDuration 
+		explicit Animation(
+			FramesPtr const& frames,	/* ֡ */
+			EaseFunc func = nullptr		/* ٶȱ仯 */
+		);
+
 		virtual ~Animation();
 
 		// ȡ
@@ -57,7 +65,13 @@ namespace easy2d
 
 		void UpdateTween(NodePtr const& target, float percent) override;
 
+		// лָ֡, ֡δ仯ʱ޸ľ
+		void ShowFrame(int index);
+
 	protected:
-		FramesPtr frames_;
+		FramesPtr	frames_;
+		Sprite*		sprite_;		// ÿ Init ʱĿ꾫
+		ImagePtr	sheet_image_;	// ͼģʽ¾ʹõͼƬ, ÿֻ֡޸Ĳü
+		int			frame_index_;
 	};
 }
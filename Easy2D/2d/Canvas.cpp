@@ -32,6 +32,9 @@ namespace easy2d
 	{
 		auto ctx = Renderer::Instance().GetDeviceResources()->GetD2DDeviceContext();
 
+		// no device context in headless mode
+		ThrowIfFailed(ctx ? S_OK : E_UNEXPECTED);
+
 		ThrowIfFailed(
 			ctx->CreateCompatibleRenderTarget(&render_target_)
 		);
@@ -86,6 +89,7 @@ namespace easy2d
 			render_target_->EndDraw()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::OnRender()
@@ -170,6 +174,7 @@ namespace easy2d
 			outline_join_style_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::DrawCircle(const Point & center, float radius)
@@ -188,6 +193,7 @@ namespace easy2d
 			outline_join_style_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::DrawEllipse(const Point & center, float radius_x, float radius_y)
@@ -206,6 +212,7 @@ namespace easy2d
 			outline_join_style_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::DrawRect(const Rect & rect)
@@ -222,6 +229,7 @@ namespace easy2d
 			outline_join_style_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::DrawRoundedRect(const Rect & rect, float radius_x, float radius_y)
@@ -242,6 +250,7 @@ namespace easy2d
 			outline_join_style_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::DrawImage(ImagePtr const & image, float opacity)
@@ -256,6 +265,7 @@ namespace easy2d
 				DX::ConvertToRectF(image->GetCropRect())
 			);
 			cache_expired_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -303,6 +313,7 @@ namespace easy2d
 				outline_join_style_.Get()
 			);
 			cache_expired_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -320,6 +331,7 @@ namespace easy2d
 			fill_brush_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::FillEllipse(const Point & center, float radius_x, float radius_y)
@@ -336,6 +348,7 @@ namespace easy2d
 			fill_brush_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::FillRect(const Rect & rect)
@@ -350,6 +363,7 @@ namespace easy2d
 			fill_brush_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::FillRoundedRect(const Rect & rect, float radius_x, float radius_y)
@@ -368,6 +382,7 @@ namespace easy2d
 			fill_brush_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::FillGeometry(GeometryPtr const & geo)
@@ -379,6 +394,7 @@ namespace easy2d
 				fill_brush_.Get()
 			);
 			cache_expired_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -465,6 +481,7 @@ namespace easy2d
 			outline_join_style_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::FillPath()
@@ -474,12 +491,14 @@ namespace easy2d
 			fill_brush_.Get()
 		);
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	void Canvas::Clear()
 	{
 		render_target_->Clear();
 		cache_expired_ = true;
+		InvalidateContent();
 	}
 
 	ImagePtr Canvas::ExportToImage() const
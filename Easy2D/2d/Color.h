@@ -57,6 +57,10 @@ namespace easy2d
 			float alpha
 		);
 
+		inline bool operator== (Color const& other) const	{ return r == other.r && g == other.g && b == other.b && a == other.a; }
+
+		inline bool operator!= (Color const& other) const	{ return !(*this == other); }
+
 	public:
 		enum Value : unsigned int
 		{
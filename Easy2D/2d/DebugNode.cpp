@@ -51,12 +51,15 @@ namespace easy2d
 
 	void DebugNode::OnRender()
 	{
-		Renderer::Instance().GetSolidColorBrush()->SetColor(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.5f));
+		ComPtr<ID2D1RectangleGeometry> background;
+		auto factory = Renderer::Instance().GetDeviceResources()->GetD2DFactory();
 
-		Renderer::Instance().GetDeviceResources()->GetD2DDeviceContext()->FillRectangle(
+		if (SUCCEEDED(factory->CreateRectangleGeometry(
 			D2D1_RECT_F{ 10, 10, 30 + debug_text_->GetWidth(), 30 + debug_text_->GetHeight() },
-			Renderer::Instance().GetSolidColorBrush()
-		);
+			&background)))
+		{
+			Renderer::Instance().FillGeometry(background, Color(0.0f, 0.0f, 0.0f, 0.5f));
+		}
 	}
 
 	void DebugNode::OnUpdate(Duration dt)
@@ -76,10 +79,19 @@ namespace easy2d
 		ss << "Objects: " << Object::__GetTracingObjects().size() << std::endl;
 #endif
 
-		ss << "Render: " << Renderer::Instance().GetStatus().duration.Milliseconds() << "ms" << std::endl;
+		ss << "Render: " << Renderer::Instance().GetStatus().duration.Seconds() * 1000.f << "ms" << std::endl;
 
 		ss << "Primitives / sec: " << Renderer::Instance().GetStatus().primitives * frame_time_.size() << std::endl;
 
+		ss << "Commands: " << Renderer::Instance().GetStatus().commands << ", "
+			<< Renderer::Instance().GetStatus().batches << " batches" << std::endl;
+
+		ss << "States: " << Renderer::Instance().GetStatus().state_changes << " set, "
+			<< Renderer::Instance().GetStatus().skipped_state_changes << " skipped" << std::endl;
+
+		ss << "Nodes: " << Renderer::Instance().GetStatus().rendered_nodes << " rendered, "
+			<< Renderer::Instance().GetStatus().culled_nodes << " culled" << std::endl;
+
 		PROCESS_MEMORY_COUNTERS_EX pmc;
 		GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc));
 		ss << "Memory: " << pmc.PrivateUsage / 1024 << "kb";
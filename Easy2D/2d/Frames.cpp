@@ -33,46 +33,230 @@ namespace easy2d
 		this->Add(frames);
 	}
 
+	Frames::Frames(ImagePtr const& sheet, Array<Rect> const& crop_rects)
+		: sheet_(sheet)
+	{
+		E2D_ASSERT(sheet && "Frames::Frames failed, NULL pointer exception");
+
+		crop_rects_.reserve(crop_rects.size());
+		durations_.reserve(crop_rects.size());
+		ends_.reserve(crop_rects.size());
+
+		for (const auto& rect : crop_rects)
+			Add(rect);
+	}
+
 	Frames::~Frames()
 	{
 	}
 
-	void Frames::Add(ImagePtr const& frame)
+	void Frames::Add(ImagePtr const& frame, Duration duration)
 	{
 		E2D_ASSERT(frame && "Frames::Add failed, NULL pointer exception");
 
 		if (frame)
 		{
+			if (sheet_)
+			{
+				// mixed frames can only be stored one image per frame
+				BuildSheetFrames();
+				sheet_ = nullptr;
+				crop_rects_.clear();
+			}
+
 			frames_.push_back(frame);
+			PushDuration(duration);
 		}
 	}
 
 	void Frames::Add(Array<ImagePtr> const& frames)
 	{
-		if (frames_.empty())
-			frames_ = frames;
+		frames_.reserve(frames_.size() + frames.size());
+		durations_.reserve(durations_.size() + frames.size());
+		ends_.reserve(ends_.size() + frames.size());
+
+		for (const auto& image : frames)
+			Add(image);
+	}
+
+	void Frames::Add(Rect const& crop_rect, Duration duration)
+	{
+		E2D_ASSERT(sheet_ && "Frames::Add failed, crop rects require a sprite sheet");
+
+		if (sheet_)
+		{
+			std::lock_guard<std::mutex> lock(sheet_mutex_);
+			frames_.clear();
+			crop_rects_.push_back(crop_rect);
+			PushDuration(duration);
+		}
+	}
+
+	void Frames::PushDuration(Duration duration)
+	{
+		if (duration < Duration())
+			duration = 0;
+
+		durations_.push_back(duration);
+		ends_.push_back(ends_.empty() ? duration : ends_.back() + duration);
+	}
+
+	void Frames::SetDuration(int index, Duration duration)
+	{
+		if (index < 0 || index >= GetFrameCount())
+			return;
+
+		if (duration < Duration())
+			duration = 0;
+
+		auto durations = durations_.begin();
+		auto ends = ends_.begin();
+		durations[index] = duration;
+
+		// rebuild the prefix sums from the changed frame on
+		Duration end = (index == 0) ? Duration() : ends[index - 1];
+		for (int i = index, count = GetFrameCount(); i < count; ++i)
+		{
+			end += durations[i];
+			ends[i] = end;
+		}
+	}
+
+	void Frames::SetEvent(int index, FrameCallback const& cb)
+	{
+		if (index < 0 || index >= GetFrameCount())
+			return;
+
+		if (cb)
+			events_[index] = cb;
 		else
+			events_.erase(index);
+	}
+
+	int Frames::GetFrameCount() const
+	{
+		return static_cast<int>(sheet_ ? crop_rects_.size() : frames_.size());
+	}
+
+	Duration Frames::GetDuration() const
+	{
+		return ends_.empty() ? Duration() : ends_.back();
+	}
+
+	Duration Frames::GetDuration(int index) const
+	{
+		if (index < 0 || index >= GetFrameCount())
+			return Duration();
+		return durations_.begin()[index];
+	}
+
+	FrameCallback const* Frames::GetEvent(int index) const
+	{
+		auto iter = events_.find(index);
+		if (iter != events_.end())
+			return &iter->second;
+		return nullptr;
+	}
+
+	bool Frames::HasEvents() const
+	{
+		return !events_.empty();
+	}
+
+	int Frames::FindFrame(float percent) const
+	{
+		const int count = GetFrameCount();
+		if (count == 0)
+			return -1;
+
+		const Duration total = GetDuration();
+		int index = 0;
+		if (total.IsZero())
 		{
-			frames_.reserve(frames_.size() + frames.size());
-			for (const auto& image : frames)
-				Add(image);
+			// equal-length frames
+			index = static_cast<int>(math::Floor(count * percent));
 		}
+		else
+		{
+			// the first frame whose end lies past the current time
+			const Duration time = total * percent;
+			auto ends = ends_.begin();
+			index = static_cast<int>(std::upper_bound(ends, ends + count, time) - ends);
+		}
+		return std::min(std::max(index, 0), count - 1);
+	}
+
+	bool Frames::IsSheet() const
+	{
+		return !!sheet_;
+	}
+
+	ImagePtr const& Frames::GetSheet() const
+	{
+		return sheet_;
+	}
+
+	Array<Rect> const& Frames::GetCropRects() const
+	{
+		return crop_rects_;
 	}
 
 	Array<ImagePtr> const& Frames::GetFrames() const
 	{
+		if (sheet_)
+			BuildSheetFrames();
 		return frames_;
 	}
 
+	ImagePtr Frames::GetFrame(int index) const
+	{
+		if (index < 0 || index >= GetFrameCount())
+			return nullptr;
+
+		if (sheet_)
+			return CreateSheetFrame(index);
+		return frames_.begin()[index];
+	}
+
+	ImagePtr Frames::CreateSheetFrame(int index) const
+	{
+		ImagePtr image = new (std::nothrow) Image(sheet_->GetBitmap());
+		if (image)
+		{
+			image->Crop(crop_rects_.begin()[index]);
+		}
+		return image;
+	}
+
+	void Frames::BuildSheetFrames() const
+	{
+		std::lock_guard<std::mutex> lock(sheet_mutex_);
+
+		const int count = GetFrameCount();
+		if (static_cast<int>(frames_.size()) == count)
+			return;
+
+		frames_.clear();
+		frames_.reserve(count);
+		for (int i = 0; i < count; ++i)
+		{
+			ImagePtr image = CreateSheetFrame(i);
+			if (image)
+				frames_.push_back(image);
+		}
+	}
+
 	FramesPtr Frames::Clone() const
 	{
 		auto animation = new (std::nothrow) Frames;
 		if (animation)
 		{
-			for (const auto& frame : frames_)
-			{
-				animation->Add(frame);
-			}
+			animation->frames_ = frames_;
+			animation->sheet_ = sheet_;
+			animation->crop_rects_ = crop_rects_;
+			animation->durations_ = durations_;
+			animation->ends_ = ends_;
+			animation->events_ = events_;
 		}
 		return animation;
 	}
@@ -80,12 +264,36 @@ namespace easy2d
 	FramesPtr Frames::Reverse() const
 	{
 		auto animation = new (std::nothrow) Frames;
-		if (!frames_.empty())
+		if (animation)
 		{
-			for (auto iter = frames_.crbegin(), crend = frames_.crend(); iter != crend; ++iter)
+			const int count = GetFrameCount();
+			auto durations = durations_.begin();
+
+			animation->sheet_ = sheet_;
+			if (sheet_)
+			{
+				auto rects = crop_rects_.begin();
+				animation->crop_rects_.reserve(count);
+				for (int i = count - 1; i >= 0; --i)
+				{
+					animation->crop_rects_.push_back(rects[i]);
+					animation->PushDuration(durations[i]);
+				}
+			}
+			else
+			{
+				auto images = frames_.begin();
+				animation->frames_.reserve(count);
+				for (int i = count - 1; i >= 0; --i)
+				{
+					animation->frames_.push_back(images[i]);
+					animation->PushDuration(durations[i]);
+				}
+			}
+
+			for (const auto& pair : events_)
 			{
-				if (*iter)
-					animation->Add(*iter);
+				animation->events_[count - 1 - pair.first] = pair.second;
 			}
 		}
 		return animation;
@@ -20,10 +20,16 @@
 
 #pragma once
 #include "include-forwards.h"
+#include <functional>
+#include <mutex>
 
 namespace easy2d
 {
+	// ֡¼
+	using FrameCallback = std::function<void()>;
+
 	// ֡
+	// ִ֧洢ʽ: ÿ֡һ Image, һͼÿ֡Ĳü
 	class E2D_API Frames
 		: public virtual Object
 	{
@@ -34,11 +40,18 @@ namespace easy2d
 			Array<ImagePtr> const& frames	/* ֡ */
 		);
 
+		explicit Frames(
+			ImagePtr const& sheet,			/* ͼ */
+			Array<Rect> const& crop_rects	/* ÿ֡Ĳü */
+		);
+
 		virtual ~Frames();
 
 		// ӹؼ֡
+		// ͼתΪÿ֡һ Image ʽ
 		void Add(
-			ImagePtr const& frame
+			ImagePtr const& frame,
+			Duration duration = 0			/* ֡ʱ */
 		);
 
 		// Ӷؼ֡
@@ -46,9 +59,67 @@ namespace easy2d
 			Array<ImagePtr> const& frames
 		);
 
+		// ͼеĹؼ֡
+		void Add(
+			Rect const& crop_rect,
+			Duration duration = 0			/* ֡ʱ */
+		);
+
+		// ֡ʱ
+		// ֡ʱΪ 0 ʱ֡ȳ, ʱ䶯ʱ
+		void SetDuration(
+			int index,
+			Duration duration
+		);
+
+		// ֡¼, ֡ʱ
+		void SetEvent(
+			int index,
+			FrameCallback const& cb
+		);
+
+		// ȡ֡
+		int GetFrameCount() const;
+
+		// ȡ֡ʱ֮
+		Duration GetDuration() const;
+
+		// ȡ֡ʱ
+		Duration GetDuration(
+			int index
+		) const;
+
+		// ȡ֡¼
+		FrameCallback const* GetEvent(
+			int index
+		) const;
+
+		// Ƿ֡¼
+		bool HasEvents() const;
+
+		// ȡȶӦ֡
+		int FindFrame(
+			float percent
+		) const;
+
+		// ǷΪͼ
+		bool IsSheet() const;
+
+		// ȡͼ
+		ImagePtr const& GetSheet() const;
+
+		// ȡͼü
+		Array<Rect> const& GetCropRects() const;
+
 		// ȡؼ֡
+		// ͼڵһεʱΪÿ֡ü Image
 		Array<ImagePtr> const& GetFrames() const;
 
+		// ȡؼ֡, ͼÿεʱü Image
+		ImagePtr GetFrame(
+			int index
+		) const;
+
 		// ȡ֡Ŀ
 		FramesPtr Clone() const;
 
@@ -56,6 +127,24 @@ namespace easy2d
 		FramesPtr Reverse() const;
 
 	protected:
-		Array<ImagePtr>	frames_;
+		void PushDuration(
+			Duration duration
+		);
+
+		ImagePtr CreateSheetFrame(
+			int index
+		) const;
+
+		// ͼÿ֡ Image
+		void BuildSheetFrames() const;
+
+	protected:
+		mutable std::mutex		sheet_mutex_;
+		mutable Array<ImagePtr>	frames_;		// ͼģʽΪɵĲüͼƬ
+		ImagePtr		sheet_;
+		Array<Rect>		crop_rects_;
+		Array<Duration>	durations_;
+		Array<Duration>	ends_;			// ֡ʱǰ׺
+		Map<int, FrameCallback> events_;
 	};
 }
@@ -44,26 +44,31 @@ namespace easy2d
 	void GeometryNode::SetGeometry(GeometryPtr const& geometry)
 	{
 		geometry_ = geometry;
+		InvalidateContent();
 	}
 
 	void GeometryNode::SetFillColor(const Color & color)
 	{
 		fill_color_ = color;
+		InvalidateContent();
 	}
 
 	void GeometryNode::SetStrokeColor(const Color & color)
 	{
 		stroke_color_ = color;
+		InvalidateContent();
 	}
 
 	void GeometryNode::SetStrokeWidth(float width)
 	{
 		stroke_width_ = std::max(width, 0.f);
+		InvalidateContent();
 	}
 
 	void GeometryNode::SetOutlineJoinStyle(StrokeStyle outline_join)
 	{
 		outline_join_ = outline_join;
+		InvalidateContent();
 	}
 
 	void GeometryNode::OnRender()
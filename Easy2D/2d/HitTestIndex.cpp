@@ -0,0 +1,249 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "HitTestIndex.h"
+#include <cmath>
+
+namespace easy2d
+{
+	namespace
+	{
+		// proxies covering too many cells are always treated as candidates
+		const int max_cells_per_proxy = 64;
+
+		// bounds are padded to absorb floating-point error of the AABB
+		const float bounds_padding = 1.f;
+	}
+
+	HitTestIndex::HitTestIndex(float cell_size)
+		: queried_(false)
+		, proxy_count_(0)
+		, stamp_(0)
+		, cell_size_(cell_size)
+	{
+	}
+
+	int HitTestIndex::Insert()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		int proxy;
+		if (!free_list_.empty())
+		{
+			proxy = free_list_.back();
+			free_list_.pop_back();
+		}
+		else
+		{
+			proxy = static_cast<int>(proxies_.size());
+			proxies_.push_back(Proxy{});
+		}
+
+		Proxy& p = proxies_[proxy];
+		p.alive = true;
+		p.large = true;
+		p.stamp = 0;
+		p.x0 = p.y0 = p.x1 = p.y1 = 0;
+
+		++proxy_count_;
+		return proxy;
+	}
+
+	void HitTestIndex::Update(int proxy, Rect const& bounds)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		Proxy& p = proxies_[proxy];
+
+		float left = bounds.GetLeft() - bounds_padding;
+		float top = bounds.GetTop() - bounds_padding;
+		float right = bounds.GetRight() + bounds_padding;
+		float bottom = bounds.GetBottom() + bounds_padding;
+
+		bool large = !(std::isfinite(left) && std::isfinite(top) && std::isfinite(right) && std::isfinite(bottom));
+
+		int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+		if (!large)
+		{
+			x0 = CellIndex(left);
+			y0 = CellIndex(top);
+			x1 = CellIndex(right);
+			y1 = CellIndex(bottom);
+
+			long long cells = (static_cast<long long>(x1) - x0 + 1) * (static_cast<long long>(y1) - y0 + 1);
+			large = (cells > max_cells_per_proxy);
+		}
+
+		if (large)
+		{
+			if (!p.large)
+			{
+				Unlink(proxy);
+				p.large = true;
+			}
+			return;
+		}
+
+		if (!p.large && p.x0 == x0 && p.y0 == y0 && p.x1 == x1 && p.y1 == y1)
+			return;
+
+		if (!p.large)
+			Unlink(proxy);
+
+		p.large = false;
+		p.x0 = x0;
+		p.y0 = y0;
+		p.x1 = x1;
+		p.y1 = y1;
+		Link(proxy);
+		UpdateStamp(proxy);
+	}
+
+	void HitTestIndex::Remove(int proxy)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		Proxy& p = proxies_[proxy];
+		if (!p.alive)
+			return;
+
+		if (!p.large)
+			Unlink(proxy);
+
+		p.alive = false;
+		p.large = false;
+		free_list_.push_back(proxy);
+		--proxy_count_;
+	}
+
+	void HitTestIndex::Clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		cells_.clear();
+		proxies_.clear();
+		free_list_.clear();
+		proxy_count_ = 0;
+		queried_ = false;
+	}
+
+	void HitTestIndex::Query(Point const& point)
+	{
+		if (++stamp_ == 0)
+		{
+			// stamp wrapped around, reset all proxies
+			for (auto& p : proxies_)
+				p.stamp = 0;
+			stamp_ = 1;
+		}
+
+		queried_ = true;
+		query_point_ = point;
+
+		auto iter = cells_.find(CellKey(CellIndex(point.x), CellIndex(point.y)));
+		if (iter != cells_.end())
+		{
+			for (int proxy : iter->second)
+			{
+				proxies_[proxy].stamp = stamp_;
+			}
+		}
+	}
+
+	bool HitTestIndex::IsQueried(Point const& point) const
+	{
+		return queried_ && query_point_ == point;
+	}
+
+	bool HitTestIndex::IsCandidate(int proxy) const
+	{
+		Proxy const& p = proxies_[proxy];
+		return p.large || p.stamp == stamp_;
+	}
+
+	void HitTestIndex::Link(int proxy)
+	{
+		Proxy const& p = proxies_[proxy];
+		for (int y = p.y0; y <= p.y1; ++y)
+		{
+			for (int x = p.x0; x <= p.x1; ++x)
+			{
+				cells_[CellKey(x, y)].push_back(proxy);
+			}
+		}
+	}
+
+	void HitTestIndex::Unlink(int proxy)
+	{
+		Proxy const& p = proxies_[proxy];
+		for (int y = p.y0; y <= p.y1; ++y)
+		{
+			for (int x = p.x0; x <= p.x1; ++x)
+			{
+				auto iter = cells_.find(CellKey(x, y));
+				if (iter == cells_.end())
+					continue;
+
+				auto& cell = iter->second;
+				for (auto& item : cell)
+				{
+					if (item == proxy)
+					{
+						item = cell.back();
+						cell.pop_back();
+						break;
+					}
+				}
+
+				if (cell.empty())
+					cells_.erase(iter);
+			}
+		}
+	}
+
+	void HitTestIndex::UpdateStamp(int proxy)
+	{
+		// keep the result of the last query valid after the proxy moved
+		if (!queried_)
+			return;
+
+		Proxy& p = proxies_[proxy];
+
+		int x = CellIndex(query_point_.x);
+		int y = CellIndex(query_point_.y);
+		if (x >= p.x0 && x <= p.x1 && y >= p.y0 && y <= p.y1)
+			p.stamp = stamp_;
+		else
+			p.stamp = 0;
+	}
+
+	long long HitTestIndex::CellKey(int x, int y) const
+	{
+		return (static_cast<long long>(x) << 32) | static_cast<unsigned int>(y);
+	}
+
+	int HitTestIndex::CellIndex(float v) const
+	{
+		float index = std::floor(v / cell_size_);
+		if (index < -1.0e9f) return -1000000000;
+		if (index > 1.0e9f) return 1000000000;
+		return static_cast<int>(index);
+	}
+}
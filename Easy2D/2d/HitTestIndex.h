@@ -0,0 +1,101 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "include-forwards.h"
+#include <mutex>
+
+namespace easy2d
+{
+	// 
+	// ʹþ¼ӦڵİΧ, ƶʱֻеĽڵȷ
+	class E2D_API HitTestIndex
+	{
+	public:
+		HitTestIndex(
+			float cell_size = 64.f
+		);
+
+		// Ӵ, ش
+		int Insert();
+
+		// ´İΧ ()
+		void Update(
+			int proxy,
+			Rect const& bounds
+		);
+
+		// Ƴ
+		void Remove(
+			int proxy
+		);
+
+		// 
+		void Clear();
+
+		// ǰõд
+		void Query(
+			Point const& point
+		);
+
+		// һβѯǷԸõ
+		bool IsQueried(
+			Point const& point
+		) const;
+
+		// Ƿܰһβѯĵ
+		bool IsCandidate(
+			int proxy
+		) const;
+
+		// ȡ
+		int GetProxyCount() const	{ return proxy_count_; }
+
+	private:
+		struct Proxy
+		{
+			bool			alive;
+			bool			large;
+			unsigned int	stamp;
+			int				x0, y0, x1, y1;
+		};
+
+		void Link(int proxy);
+
+		void Unlink(int proxy);
+
+		void UpdateStamp(int proxy);
+
+		long long CellKey(int x, int y) const;
+
+		int CellIndex(float v) const;
+
+	private:
+		bool			queried_;
+		int				proxy_count_;
+		unsigned int	stamp_;
+		float			cell_size_;
+		Point			query_point_;
+		Array<Proxy>	proxies_;
+		Array<int>		free_list_;
+		UnorderedMap<long long, Array<int>> cells_;
+		std::mutex		mutex_;
+	};
+}
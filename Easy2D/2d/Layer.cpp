@@ -47,14 +47,12 @@ namespace easy2d
 		if (!IsVisible())
 			return;
 
-		NodePtr prev;
-		for (auto child = children_.Last(); child; child = prev)
+		for (Children::Iterator iter(children_, true); iter; iter.Next())
 		{
-			prev = child->PrevItem();
-			child->Dispatch(evt);
+			iter->Dispatch(evt);
 		}
 
-		EventDispatcher::Dispatch(evt);
+		DispatchListeners(evt);
 	}
 
 	void Layer::HandleMessages(Event const & evt)
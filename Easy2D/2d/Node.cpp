@@ -21,8 +21,11 @@
 #include "Node.h"
 #include "Action.h"
 #include "Scene.h"
+#include "../base/ObjectPool.h"
 #include "../base/logs.h"
+#include "../base/Trace.h"
 #include "../renderer/render.h"
+#include <atomic>
 
 namespace easy2d
 {
@@ -30,8 +33,46 @@ namespace easy2d
 	{
 		float default_anchor_x = 0.f;
 		float default_anchor_y = 0.f;
+
+		// children with the same Z-Order are sorted by the time of setting
+		std::atomic<unsigned long long> z_order_seq(0);
+
+		Rect UnionRect(Rect const& a, Rect const& b)
+		{
+			float left = std::min(a.GetLeft(), b.GetLeft());
+			float top = std::min(a.GetTop(), b.GetTop());
+			float right = std::max(a.GetRight(), b.GetRight());
+			float bottom = std::max(a.GetBottom(), b.GetBottom());
+			return Rect{ left, top, right - left, bottom - top };
+		}
 	}
 
+	struct Node::Extension
+		: public TimerManager
+		, public ActionManager
+		, public EventDispatcher
+	{
+		UpdateCallback	cb_update;
+		Matrix			transform_matrix_inverse;
+
+		// state of the subtree captured in the bitmap cache
+		ComPtr<ID2D1Bitmap1>	cache_bitmap;
+		Rect			cache_area;
+		Matrix			cache_transform;
+		float			cache_opacity;
+		Size			cache_output_size;
+
+		using TimerManager::UpdateTimers;
+		using ActionManager::UpdateActions;
+		using ActionManager::DetachTweens;
+
+		inline bool IsIdle() const	{ return actions_.IsEmpty() && timers_.IsEmpty() && !cb_update; }
+
+		static void* operator new(size_t size)		{ return ObjectPool::Allocate(size); }
+
+		static void operator delete(void* ptr)		{ ObjectPool::Deallocate(ptr); }
+	};
+
 	void Node::SetDefaultAnchor(float anchor_x, float anchor_y)
 	{
 		default_anchor_x = anchor_x;
@@ -41,98 +82,464 @@ namespace easy2d
 	Node::Node()
 		: visible_(true)
 		, update_pausing_(false)
+		, dirty_sort_(false)
+		, dirty_opacity_(true)
+		, awake_(true)
+		, skip_on_update_(false)
+		, parallel_root_(false)
+		, cache_as_bitmap_(false)
+		, dirty_cache_(true)
 		, hover_(false)
 		, pressed_(false)
 		, responsible_(false)
 		, dirty_transform_(false)
-		, dirty_transform_inverse_(false)
+		, dirty_transform_inverse_(true)
+		, dirty_bounds_(true)
+		, infinite_bounds_(true)
 		, parent_(nullptr)
 		, scene_(nullptr)
 		, hash_name_(0)
 		, z_order_(0)
+		, z_order_seq_(0)
+		, hit_proxy_(-1)
+		, transform_slot_(-1)
+		, transform_version_(0)
 		, opacity_(1.f)
 		, display_opacity_(1.f)
 		, anchor_(default_anchor_x, default_anchor_y)
 	{
 	}
 
-	void Node::Update(Duration dt)
+	Node::~Node()
 	{
-		if (update_pausing_)
-			return;
+	}
 
-		UpdateActions(this, dt);
-		UpdateTimers(dt);
+	void Node::Update(Duration dt)
+	{
+		E2D_PROFILE_SCOPE("Node::Update");
 
-		if (cb_update_)
-			cb_update_(dt);
+		if (update_pausing_ || !awake_)
+			return;
 
-		OnUpdate(dt);
+		bool busy = UpdateSelf(dt);
 
 		if (!children_.IsEmpty())
 		{
-			NodePtr next;
-			for (auto child = children_.First(); child; child = next)
+			SortChildren();
+
+			for (Children::Iterator iter(children_); iter; iter.Next())
 			{
-				next = child->NextItem();
+				Node* child = iter.Get();
 				child->Update(dt);
+
+				if (child->awake_)
+					busy = true;
 			}
 		}
+
+		if (busy)
+			awake_ = true;
+	}
+
+	bool Node::UpdateSelf(Duration dt)
+	{
+		// WakeUp() called during this update will set it back
+		awake_ = false;
+
+		if (extension_)
+		{
+			extension_->UpdateActions(this, dt);
+			extension_->UpdateTimers(dt);
+
+			if (extension_->cb_update)
+				extension_->cb_update(dt);
+		}
+
+		if (!skip_on_update_)
+			OnUpdate(dt);
+
+		return (extension_ && !extension_->IsIdle()) || !skip_on_update_;
+	}
+
+	void Node::OnUpdate(Duration dt)
+	{
+		E2D_NOT_USED(dt);
+
+		// not overridden, no need to call it any more
+		skip_on_update_ = true;
+	}
+
+	void Node::WakeUp()
+	{
+		for (Node* node = this; node && !node->awake_; node = node->parent_)
+		{
+			node->awake_ = true;
+
+			// ancestors are shared by other threads, the scene wakes them up after the parallel phase
+			if (node->parallel_root_)
+				break;
+		}
+	}
+
+	Node::Extension& Node::GetExtension() const
+	{
+		if (!extension_)
+			extension_.reset(new Extension);
+		return *extension_;
+	}
+
+	void Node::SetCallbackOnUpdate(UpdateCallback const& cb)
+	{
+		if (!cb && !extension_)
+			return;
+
+		GetExtension().cb_update = cb;
+		WakeUp();
+	}
+
+	Node::UpdateCallback const& Node::GetCallbackOnUpdate() const
+	{
+		static const UpdateCallback empty;
+		return extension_ ? extension_->cb_update : empty;
+	}
+
+	ActionPtr Node::AddAction(ActionPtr const& action)
+	{
+		WakeUp();
+		return GetExtension().AddAction(action);
+	}
+
+	ActionPtr Node::GetAction(String const& name)
+	{
+		return extension_ ? extension_->GetAction(name) : nullptr;
+	}
+
+	void Node::ResumeAllActions()
+	{
+		if (extension_)
+			extension_->ResumeAllActions();
+	}
+
+	void Node::PauseAllActions()
+	{
+		if (extension_)
+			extension_->PauseAllActions();
+	}
+
+	void Node::StopAllActions()
+	{
+		if (extension_)
+			extension_->StopAllActions();
+	}
+
+	Node::Actions const& Node::GetAllActions() const
+	{
+		static const Actions empty;
+		return extension_ ? extension_->GetAllActions() : empty;
+	}
+
+	void Node::AddTimer(TimerPtr const& timer)
+	{
+		WakeUp();
+		GetExtension().AddTimer(timer);
+	}
+
+	void Node::StartTimers(String const& timer_name)
+	{
+		if (extension_)
+			extension_->StartTimers(timer_name);
+	}
+
+	void Node::StopTimers(String const& timer_name)
+	{
+		if (extension_)
+			extension_->StopTimers(timer_name);
+	}
+
+	void Node::RemoveTimers(String const& timer_name)
+	{
+		if (extension_)
+			extension_->RemoveTimers(timer_name);
+	}
+
+	void Node::StartAllTimers()
+	{
+		if (extension_)
+			extension_->StartAllTimers();
+	}
+
+	void Node::StopAllTimers()
+	{
+		if (extension_)
+			extension_->StopAllTimers();
+	}
+
+	void Node::RemoveAllTimers()
+	{
+		if (extension_)
+			extension_->RemoveAllTimers();
+	}
+
+	Node::Timers const& Node::GetAllTimers() const
+	{
+		static const Timers empty;
+		return extension_ ? extension_->GetAllTimers() : empty;
+	}
+
+	EventListenerPtr Node::AddListener(EventListenerPtr const& listener)
+	{
+		return GetExtension().AddListener(listener);
+	}
+
+	void Node::AddListener(UINT type, EventCallback callback, String const& name)
+	{
+		GetExtension().AddListener(type, callback, name);
+	}
+
+	void Node::StartListeners(String const& listener_name)
+	{
+		if (extension_)
+			extension_->StartListeners(listener_name);
+	}
+
+	void Node::StopListeners(String const& listener_name)
+	{
+		if (extension_)
+			extension_->StopListeners(listener_name);
+	}
+
+	void Node::RemoveListeners(String const& listener_name)
+	{
+		if (extension_)
+			extension_->RemoveListeners(listener_name);
+	}
+
+	void Node::StartListeners(UINT type)
+	{
+		if (extension_)
+			extension_->StartListeners(type);
+	}
+
+	void Node::StopListeners(UINT type)
+	{
+		if (extension_)
+			extension_->StopListeners(type);
+	}
+
+	void Node::RemoveListeners(UINT type)
+	{
+		if (extension_)
+			extension_->RemoveListeners(type);
+	}
+
+	void Node::DispatchListeners(Event& evt)
+	{
+		if (extension_)
+			extension_->Dispatch(evt);
 	}
 
 	void Node::Render()
 	{
+		E2D_PROFILE_SCOPE("Node::Render");
+
+		// hidden and transparent subtrees draw nothing and are left out of their parent's bounds,
+		// but the flag must still be reset or on-demand rendering would redraw forever
 		if (!visible_)
+		{
+			dirty_bounds_ = false;
 			return;
+		}
 
 		UpdateTransform();
+		UpdateOpacity();
+
+		if (display_opacity_ <= 0.f)
+		{
+			dirty_bounds_ = false;
+			return;
+		}
+
+		SortChildren();
+
+		auto& renderer = Renderer::Instance();
+
+		// skip subtrees whose cached bounds are out of the visible area,
+		// a node is only counted as culled when it is not drawn at its interpolated position either
+		if (!dirty_bounds_ && !infinite_bounds_ && !renderer.IsInVisibleArea(bounds_) && !IsVisibleWhenInterpolated())
+		{
+			renderer.IncreaseCulledNodes();
+			return;
+		}
+
+		if (!cache_as_bitmap_ || !RenderCache())
+			RenderSubtree();
+
+		if (dirty_bounds_)
+			UpdateBounds();
+	}
+
+	void Node::RenderSubtree()
+	{
+		auto& renderer = Renderer::Instance();
 
 		if (children_.IsEmpty())
 		{
 			PrepareRender();
 			OnRender();
+			renderer.IncreaseRenderedNodes();
 		}
 		else
 		{
 			// render children those are less than 0 in Z-Order
-			Node* child = children_.First().Get();
+			Node* child = children_.First();
 			while (child)
 			{
 				if (child->GetZOrder() >= 0)
 					break;
 
 				child->Render();
-				child = child->NextItem().Get();
+				child = child->NextItem();
 			}
 
 			PrepareRender();
 			OnRender();
+			renderer.IncreaseRenderedNodes();
 
 			while (child)
 			{
 				child->Render();
-				child = child->NextItem().Get();
+				child = child->NextItem();
 			}
 		}
 	}
 
+	bool Node::IsVisibleWhenInterpolated() const
+	{
+		if (transform_slot_ < 0)
+			return false;
+
+		TransformCache const& cache = scene_->GetTransformCache();
+		if (!cache.IsInterpolating())
+			return false;
+
+		Matrix render_matrix = cache.GetRenderMatrix(transform_slot_);
+		if (render_matrix == transform_matrix_ || !transform_matrix_.IsInvertible())
+			return false;
+
+		// move the bounds from where the node is to where it is drawn
+		Matrix inverse = Matrix::Invert(transform_matrix_);
+		Matrix correction = inverse * render_matrix;
+		return Renderer::Instance().IsInVisibleArea(correction.Transform(bounds_));
+	}
+
+	bool Node::RenderCache()
+	{
+		// descendants are drawn between two states that change every frame, the bitmap would go stale
+		if (transform_slot_ >= 0 && scene_->GetTransformCache().IsInterpolating())
+			return false;
+
+		auto& renderer = Renderer::Instance();
+		Extension& extension = GetExtension();
+
+		// the cache is captured in screen space, so it also expires when the node moves
+		bool valid = extension.cache_bitmap && !dirty_cache_ &&
+			extension.cache_transform == transform_matrix_ &&
+			extension.cache_opacity == display_opacity_ &&
+			extension.cache_output_size == renderer.GetOutputSize();
+
+		if (!valid)
+		{
+			// a subtree that is still changing is cheaper to draw directly
+			if (dirty_bounds_)
+				return false;
+
+			Size const& output_size = renderer.GetOutputSize();
+			Rect area{ Point{}, output_size };
+			if (!infinite_bounds_)
+			{
+				// antialiased edges may bleed one pixel out of the bounds
+				float left = std::max(std::floor(bounds_.GetLeft()) - 1.f, 0.f);
+				float top = std::max(std::floor(bounds_.GetTop()) - 1.f, 0.f);
+				float right = std::min(std::ceil(bounds_.GetRight()) + 1.f, output_size.x);
+				float bottom = std::min(std::ceil(bounds_.GetBottom()) + 1.f, output_size.y);
+				area = Rect{ left, top, right - left, bottom - top };
+			}
+
+			if (area.size.x <= 0.f || area.size.y <= 0.f)
+				return false;
+
+			if (!extension.cache_bitmap || extension.cache_area.size != area.size)
+			{
+				if (FAILED(renderer.CreateTargetBitmap(extension.cache_bitmap, area.size)))
+					extension.cache_bitmap = nullptr;
+			}
+
+			if (renderer.PushTarget(extension.cache_bitmap, area) != S_OK)
+			{
+				extension.cache_bitmap = nullptr;
+				return false;
+			}
+
+			RenderSubtree();
+			renderer.PopTarget();
+
+			dirty_cache_ = false;
+			extension.cache_area = area;
+			extension.cache_transform = transform_matrix_;
+			extension.cache_opacity = display_opacity_;
+			extension.cache_output_size = output_size;
+		}
+
+		// descendants are drawn with their own opacities, the bitmap is copied as is
+		renderer.SetTransform(Matrix::Translation(extension.cache_area.origin));
+		renderer.SetOpacity(1.f);
+		renderer.DrawBitmap(extension.cache_bitmap);
+		renderer.IncreaseRenderedNodes();
+		return true;
+	}
+
+	void Node::SetCacheAsBitmap(bool enable)
+	{
+		if (cache_as_bitmap_ == enable)
+			return;
+
+		cache_as_bitmap_ = enable;
+		dirty_cache_ = true;
+
+		if (!enable && extension_)
+			extension_->cache_bitmap = nullptr;
+	}
+
 	void Node::Dispatch(Event& evt)
 	{
 		if (!visible_)
 			return;
 
-		NodePtr prev;
-		for (auto child = children_.Last(); child; child = prev)
+		SortChildren();
+
+		for (Children::Iterator iter(children_, true); iter; iter.Next())
 		{
-			prev = child->PrevItem();
-			child->Dispatch(evt);
+			iter->Dispatch(evt);
 		}
 
 		if (responsible_ && MouseEvent::Check(evt.type))
 		{
 			if (evt.type == Event::MouseMove)
 			{
-				if (!evt.target && ContainsPoint(Point{ evt.mouse.x, evt.mouse.y }))
+				Point point{ evt.mouse.x, evt.mouse.y };
+
+				// nodes outside the cells around the cursor can't contain it
+				bool candidate = true;
+				if (hit_proxy_ >= 0)
+				{
+					UpdateTransform();
+
+					HitTestIndex const& index = scene_->GetHitTestIndex();
+					if (index.IsQueried(point))
+						candidate = index.IsCandidate(hit_proxy_);
+				}
+
+				if (!evt.target && candidate && ContainsPoint(point))
 				{
 					evt.target = this;
 
@@ -142,7 +549,7 @@ namespace easy2d
 
 						Event hover = evt;
 						hover.type = Event::MouseHover;
-						EventDispatcher::Dispatch(hover);
+						DispatchListeners(hover);
 					}
 				}
 				else if (hover_)
@@ -153,7 +560,7 @@ namespace easy2d
 					Event out = evt;
 					out.target = this;
 					out.type = Event::MouseOut;
-					EventDispatcher::Dispatch(out);
+					DispatchListeners(out);
 				}
 			}
 
@@ -170,11 +577,11 @@ namespace easy2d
 
 				Event click = evt;
 				click.type = Event::Click;
-				EventDispatcher::Dispatch(click);
+				DispatchListeners(click);
 			}
 		}
 
-		EventDispatcher::Dispatch(evt);
+		DispatchListeners(evt);
 	}
 
 	Matrix const & Node::GetTransformMatrix()  const
@@ -186,100 +593,255 @@ namespace easy2d
 	Matrix const & Node::GetTransformInverseMatrix()  const
 	{
 		UpdateTransform();
+
+		Extension& extension = GetExtension();
 		if (dirty_transform_inverse_)
 		{
-			transform_matrix_inverse_ = Matrix::Invert(transform_matrix_);
+			extension.transform_matrix_inverse = Matrix::Invert(transform_matrix_);
 			dirty_transform_inverse_ = false;
 		}
-		return transform_matrix_inverse_;
+		return extension.transform_matrix_inverse;
 	}
 
 	void Node::UpdateTransform() const
 	{
-		if (!dirty_transform_)
-			return;
+		if (transform_slot_ >= 0)
+		{
+			// nodes in a scene read their world matrix from the scene's cache
+			TransformCache& cache = scene_->GetTransformCache();
+			cache.Validate(transform_slot_);
+
+			dirty_transform_ = false;
+
+			unsigned int version = cache.GetWorldVersion(transform_slot_);
+			if (transform_version_ == version)
+				return;
+
+			transform_version_ = version;
+			transform_matrix_ = cache.GetWorldMatrix(transform_slot_);
+		}
+		else
+		{
+			if (!dirty_transform_)
+				return;
+
+			dirty_transform_ = false;
+
+			if (parent_)
+				transform_matrix_ = GetLocalMatrix() * parent_->transform_matrix_;
+			else
+				transform_matrix_ = GetLocalMatrix();
+
+			// update children's transform
+			for (Node* child = children_.First(); child; child = child->NextItem())
+				child->dirty_transform_ = true;
+		}
 
-		dirty_transform_ = false;
 		dirty_transform_inverse_ = true;
+		dirty_bounds_ = true;
 
-		transform_matrix_ = transform_.ToMatrix();
+		if (hit_proxy_ >= 0)
+			UpdateHitProxy();
+	}
 
-		Point offset{ -size_.x * anchor_.x, -size_.y * anchor_.y };
-		transform_matrix_.Translate(offset);
+	Matrix Node::GetLocalMatrix() const
+	{
+		Matrix local = transform_.ToMatrix();
+		local.Translate(Point{ -size_.x * anchor_.x, -size_.y * anchor_.y });
+		return local;
+	}
 
-		if (parent_)
-			transform_matrix_ = transform_matrix_ * parent_->transform_matrix_;
+	void Node::InsertHitProxy()
+	{
+		hit_proxy_ = scene_->GetHitTestIndex().Insert();
 
-		// update children's transform
-		for (Node* child = children_.First().Get(); child; child = child->NextItem().Get())
-			child->dirty_transform_ = true;
+		UpdateTransform();
+		UpdateHitProxy();
 	}
 
-	void Node::UpdateOpacity()
+	void Node::UpdateHitProxy() const
 	{
-		if (parent_)
+		scene_->GetHitTestIndex().Update(hit_proxy_, transform_matrix_.Transform(GetBounds()));
+	}
+
+	void Node::UpdateBounds()
+	{
+		dirty_bounds_ = false;
+
+		// nodes without size may draw anything, never cull them
+		infinite_bounds_ = (size_.x == 0.f || size_.y == 0.f);
+		if (infinite_bounds_)
+			return;
+
+		bounds_ = transform_matrix_.Transform(GetBounds());
+
+		for (Node* child = children_.First(); child; child = child->NextItem())
 		{
-			display_opacity_ = opacity_ * parent_->display_opacity_;
+			if (!child->visible_ || child->display_opacity_ <= 0.f)
+				continue;
+
+			if (child->dirty_bounds_ || child->infinite_bounds_)
+			{
+				infinite_bounds_ = true;
+				break;
+			}
+			bounds_ = UnionRect(bounds_, child->bounds_);
 		}
-		for (Node* child = children_.First().Get(); child; child = child->NextItem().Get())
+	}
+
+	void Node::InvalidateTransform()
+	{
+		dirty_transform_ = true;
+
+		if (transform_slot_ >= 0)
+			scene_->GetTransformCache().MarkDirty(transform_slot_);
+
+		InvalidateBounds();
+	}
+
+	void Node::InvalidateBounds()
+	{
+		for (Node* node = this; node; node = node->parent_)
 		{
-			child->UpdateOpacity();
+			node->dirty_bounds_ = true;
+			node->dirty_cache_ = true;
+
+			if (node->parallel_root_)
+				break;
 		}
 	}
 
-	void Node::SetScene(Scene* scene)
+	void Node::InvalidateContent()
 	{
-		if (scene && scene_ != scene)
+		// only nodes cached as bitmaps read the flag, the task root
+		// keeps it for the walk that continues after the parallel update
+		for (Node* node = this; node; node = node->parent_)
 		{
-			scene_ = scene;
-			for (Node* child = children_.First().Get(); child; child = child->NextItem().Get())
-			{
-				child->scene_ = scene;
-			}
+			node->dirty_cache_ = true;
+
+			if (node->parallel_root_)
+				break;
 		}
 	}
 
-	void Node::SetZOrder(int zorder)
+	void Node::UpdateOpacity()
 	{
-		z_order_ = zorder;
+		if (!dirty_opacity_)
+			return;
+
+		dirty_opacity_ = false;
 
 		if (parent_)
+			display_opacity_ = opacity_ * parent_->display_opacity_;
+		else
+			display_opacity_ = opacity_;
+
+		// update children's opacity
+		for (Node* child = children_.First(); child; child = child->NextItem())
+			child->dirty_opacity_ = true;
+	}
+
+	void Node::SetScene(Scene* scene)
+	{
+		if (scene_ == scene)
+			return;
+
+		if (scene_ && extension_)
+			extension_->DetachTweens();
+
+		if (hit_proxy_ >= 0)
 		{
-			NodePtr me = this;
+			scene_->GetHitTestIndex().Remove(hit_proxy_);
+			hit_proxy_ = -1;
+		}
 
-			parent_->children_.Remove(me);
+		if (transform_slot_ >= 0)
+		{
+			scene_->GetTransformCache().Remove(transform_slot_);
+			transform_slot_ = -1;
+			dirty_transform_ = true;
+		}
 
-			Node* sibling = parent_->children_.Last().Get();
+		scene_ = scene;
 
-			if (sibling && sibling->GetZOrder() > zorder)
-			{
-				sibling = sibling->PrevItem().Get();
-				while (sibling)
-				{
-					if (sibling->GetZOrder() <= zorder)
-						break;
-					sibling = sibling->PrevItem().Get();
-				}
-			}
+		if (scene_)
+		{
+			transform_slot_ = scene_->GetTransformCache().Insert(this, parent_ ? parent_->transform_slot_ : -1);
+			transform_version_ = 0;
 
-			if (sibling)
-			{
-				parent_->children_.InsertAfter(me, sibling);
-			}
-			else
+			if (responsible_)
+				InsertHitProxy();
+		}
+
+		for (Node* child = children_.First(); child; child = child->NextItem())
+		{
+			child->SetScene(scene);
+		}
+	}
+
+	bool Node::IsInParallelPhase() const
+	{
+		return scene_ && scene_->IsUpdatingInParallel();
+	}
+
+	void Node::SetZOrder(int zorder)
+	{
+		if (parallel_root_)
+		{
+			// siblings are updated by other threads
+			NodePtr self(this);
+			scene_->Defer([self, zorder]() { self->SetZOrder(zorder); });
+			return;
+		}
+
+		z_order_ = zorder;
+		z_order_seq_ = ++z_order_seq;
+
+		if (parent_)
+			parent_->InvalidateContent();
+
+		if (parent_ && !parent_->dirty_sort_)
+		{
+			// the node goes after all siblings with a lower or the same Z-Order
+			Node* prev = PrevItem();
+			Node* next = NextItem();
+
+			if ((prev && prev->z_order_ > zorder) || (next && next->z_order_ <= zorder))
 			{
-				parent_->children_.PushFront(me);
+				parent_->dirty_sort_ = true;
 			}
 		}
 	}
 
+	void Node::SortChildren()
+	{
+		if (!dirty_sort_)
+			return;
+
+		dirty_sort_ = false;
+
+		children_.Sort([](Node* lhs, Node* rhs)
+		{
+			return lhs->z_order_ < rhs->z_order_ ||
+				(lhs->z_order_ == rhs->z_order_ && lhs->z_order_seq_ < rhs->z_order_seq_);
+		});
+	}
+
 	void Node::SetOpacity(float opacity)
 	{
 		if (opacity_ == opacity)
 			return;
 
-		display_opacity_ = opacity_ = std::min(std::max(opacity, 0.f), 1.f);
-		UpdateOpacity();
+		opacity = std::min(std::max(opacity, 0.f), 1.f);
+
+		// transparent nodes are excluded from their parent's bounds
+		if ((opacity_ <= 0.f) != (opacity <= 0.f))
+			InvalidateBounds();
+		else
+			InvalidateContent();
+
+		opacity_ = opacity;
+		dirty_opacity_ = true;
 	}
 
 	void Node::SetAnchorX(float anchor_x)
@@ -299,7 +861,7 @@ namespace easy2d
 
 		anchor_.x = anchor_x;
 		anchor_.y = anchor_y;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::SetWidth(float width)
@@ -324,26 +886,44 @@ namespace easy2d
 
 		size_.x = width;
 		size_.y = height;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::SetTransform(Transform const& transform)
 	{
 		transform_ = transform;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::SetVisible(bool val)
 	{
+		if (visible_ == val)
+			return;
+
 		visible_ = val;
+		InvalidateBounds();
 	}
 
 	void Node::SetName(String const& name)
 	{
 		if (!IsName(name))
 		{
+			if (parallel_root_)
+			{
+				// the name index of parent is shared by other threads
+				NodePtr self(this);
+				scene_->Defer([self, name]() { self->SetName(name); });
+				return;
+			}
+
+			if (parent_)
+				parent_->UnindexChildName(this);
+
 			Object::SetName(name);
 			hash_name_ = std::hash<String>{}(name);
+
+			if (parent_)
+				parent_->IndexChildName(this);
 		}
 	}
 
@@ -369,7 +949,7 @@ namespace easy2d
 
 		transform_.position.x = x;
 		transform_.position.y = y;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::Move(float x, float y)
@@ -404,7 +984,7 @@ namespace easy2d
 
 		transform_.scale.x = scale_x;
 		transform_.scale.y = scale_y;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::SetSkewX(float skew_x)
@@ -424,7 +1004,7 @@ namespace easy2d
 
 		transform_.skew.x = skew_x;
 		transform_.skew.y = skew_y;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::SetRotation(float angle)
@@ -433,7 +1013,7 @@ namespace easy2d
 			return;
 
 		transform_.rotation = angle;
-		dirty_transform_ = true;
+		InvalidateTransform();
 	}
 
 	void Node::AddChild(NodePtr const& child)
@@ -442,6 +1022,13 @@ namespace easy2d
 
 		if (child)
 		{
+			if (IsInParallelPhase())
+			{
+				NodePtr self(this);
+				scene_->Defer([self, child]() { self->AddChild(child); });
+				return;
+			}
+
 #ifdef E2D_DEBUG
 
 			if (child->parent_)
@@ -453,12 +1040,16 @@ namespace easy2d
 
 #endif // E2D_DEBUG
 
-			children_.PushBack(child);
+			children_.PushBack(child.Get());
 			child->parent_ = this;
+			IndexChildName(child.Get());
 			child->SetScene(this->scene_);
-			child->dirty_transform_ = true;
-			child->UpdateOpacity();
+			child->InvalidateTransform();
+			child->dirty_opacity_ = true;
 			child->SetZOrder(child->GetZOrder());
+
+			if (child->awake_)
+				WakeUp();
 		}
 	}
 
@@ -483,34 +1074,102 @@ namespace easy2d
 	Array<NodePtr> Node::GetChildren(String const& name) const
 	{
 		Array<NodePtr> children;
-		size_t hash_code = std::hash<String>{}(name);
+		VisitChildren(name, [&](Node* child) { children.push_back(child); });
+
+		// the name index keeps insertion order, return them in children order
+		std::stable_sort(children.begin(), children.end(), [](NodePtr const& lhs, NodePtr const& rhs)
+		{
+			return lhs->z_order_ < rhs->z_order_ ||
+				(lhs->z_order_ == rhs->z_order_ && lhs->z_order_seq_ < rhs->z_order_seq_);
+		});
+		return children;
+	}
+
+	NodePtr Node::GetChild(String const& name) const
+	{
+		Array<Node*> const* candidates = FindChildren(name);
+		if (!candidates)
+			return nullptr;
 
-		for (Node* child = children_.First().Get(); child; child = child->NextItem().Get())
+		Node* found = nullptr;
+		for (Node* child : *candidates)
 		{
-			if (child->hash_name_ == hash_code && child->IsName(name))
+			if (!child->IsName(name))
+				continue;
+
+			if (!found)
+			{
+				found = child;
+				continue;
+			}
+
+			// duplicated names, return the first one in children order
+			const_cast<Node*>(this)->SortChildren();
+			for (Node* node = children_.First(); node; node = node->NextItem())
 			{
-				children.push_back(child);
+				if (node->hash_name_ == child->hash_name_ && node->IsName(name))
+					return node;
 			}
 		}
-		return children;
+		return found;
 	}
 
-	NodePtr Node::GetChild(String const& name) const
+	Array<Node*> const* Node::FindChildren(String const& name) const
 	{
-		size_t hash_code = std::hash<String>{}(name);
+		if (children_.IsEmpty())
+			return nullptr;
 
-		for (Node* child = children_.First().Get(); child; child = child->NextItem().Get())
+		if (!name_index_)
 		{
-			if (child->hash_name_ == hash_code && child->IsName(name))
+			// build index lazily on the first lookup
+			name_index_.reset(new NameIndex);
+			for (Node* child = children_.First(); child; child = child->NextItem())
 			{
-				return child;
+				if (child->hash_name_)
+					(*name_index_)[child->hash_name_].push_back(child);
 			}
 		}
-		return nullptr;
+
+		auto iter = name_index_->find(std::hash<String>{}(name));
+		if (iter == name_index_->end())
+			return nullptr;
+		return &iter->second;
+	}
+
+	void Node::IndexChildName(Node* child)
+	{
+		if (name_index_ && child->hash_name_)
+		{
+			(*name_index_)[child->hash_name_].push_back(child);
+		}
+	}
+
+	void Node::UnindexChildName(Node* child)
+	{
+		if (!name_index_ || !child->hash_name_)
+			return;
+
+		auto iter = name_index_->find(child->hash_name_);
+		if (iter == name_index_->end())
+			return;
+
+		auto& children = iter->second;
+		for (auto item = children.begin(); item != children.end(); ++item)
+		{
+			if (*item == child)
+			{
+				children.erase(item);
+				break;
+			}
+		}
+
+		if (children.empty())
+			name_index_->erase(iter);
 	}
 
 	Node::Children const & Node::GetChildren() const
 	{
+		const_cast<Node*>(this)->SortChildren();
 		return children_;
 	}
 
@@ -536,9 +1195,26 @@ namespace easy2d
 
 		if (child)
 		{
+			if (IsInParallelPhase())
+			{
+				if (child->parent_ != this)
+					return false;
+
+				NodePtr self(this);
+				NodePtr ptr(child);
+				scene_->Defer([self, ptr]()
+				{
+					if (ptr->parent_ == self.Get())
+						self->RemoveChild(ptr.Get());
+				});
+				return true;
+			}
+
+			InvalidateBounds();
+			UnindexChildName(child);
 			child->parent_ = nullptr;
 			if (child->scene_) child->SetScene(nullptr);
-			children_.Remove(NodePtr(child));
+			children_.Remove(child);
 			return true;
 		}
 		return false;
@@ -546,33 +1222,75 @@ namespace easy2d
 
 	void Node::RemoveChildren(String const& child_name)
 	{
-		if (children_.IsEmpty())
+		if (IsInParallelPhase())
 		{
+			NodePtr self(this);
+			scene_->Defer([self, child_name]() { self->RemoveChildren(child_name); });
 			return;
 		}
 
+		if (!FindChildren(child_name))
+			return;
+
+		// take the whole bucket out of the index, then remove matched children
 		size_t hash_code = std::hash<String>{}(child_name);
+		auto iter = name_index_->find(hash_code);
 
-		Node* next;
-		for (Node* child = children_.First().Get(); child; child = next)
-		{
-			next = child->NextItem().Get();
+		Array<Node*> candidates;
+		candidates.swap(iter->second);
+		name_index_->erase(iter);
 
-			if (child->hash_name_ == hash_code && child->IsName(child_name))
+		for (Node* child : candidates)
+		{
+			if (child->IsName(child_name))
 			{
 				RemoveChild(child);
 			}
+			else
+			{
+				IndexChildName(child);
+			}
 		}
 	}
 
 	void Node::RemoveAllChildren()
 	{
+		if (IsInParallelPhase())
+		{
+			NodePtr self(this);
+			scene_->Defer([self]() { self->RemoveAllChildren(); });
+			return;
+		}
+
+		InvalidateBounds();
+		name_index_.reset();
+		for (Node* child = children_.First(); child; child = child->NextItem())
+		{
+			child->parent_ = nullptr;
+			if (child->scene_) child->SetScene(nullptr);
+		}
 		children_.Clear();
 	}
 
 	void Node::SetResponsible(bool enable)
 	{
+		if (responsible_ == enable)
+			return;
+
 		responsible_ = enable;
+
+		if (scene_)
+		{
+			if (responsible_)
+			{
+				InsertHitProxy();
+			}
+			else if (hit_proxy_ >= 0)
+			{
+				scene_->GetHitTestIndex().Remove(hit_proxy_);
+				hit_proxy_ = -1;
+			}
+		}
 	}
 
 	bool Node::ContainsPoint(const Point& point) const
@@ -587,7 +1305,11 @@ namespace easy2d
 
 	void VisualNode::PrepareRender()
 	{
-		Renderer::Instance().SetTransform(transform_matrix_);
+		// the scene may blend between the last two fixed-step states
+		if (transform_slot_ >= 0)
+			Renderer::Instance().SetTransform(scene_->GetTransformCache().GetRenderMatrix(transform_slot_));
+		else
+			Renderer::Instance().SetTransform(transform_matrix_);
 		Renderer::Instance().SetOpacity(display_opacity_);
 	}
 
@@ -32,23 +32,30 @@ namespace easy2d
 	// ڵ
 	class E2D_API Node
 		: public virtual Object
-		, public TimerManager
-		, public ActionManager
-		, public EventDispatcher
-		, public IntrusiveListItem<NodePtr>
+		, public IntrusiveRawListItem<Node>
 	{
 		friend class Application;
 		friend class Transition;
-		friend class IntrusiveList<NodePtr>;
+		friend class Scene;
+		friend class TransformCache;
+		friend class IntrusiveRawList<Node>;
 
-		using Children = IntrusiveList<NodePtr>;
+		using Children = IntrusiveRawList<Node>;
+		using Actions = IntrusiveRawList<Action>;
+		using Timers = IntrusiveRawList<Timer>;
 		using UpdateCallback = std::function<void(Duration)>;
+		using NameIndex = UnorderedMap<size_t, Array<Node*>>;
+
+		struct Extension;
 
 	public:
 		Node();
 
+		virtual ~Node();
+
 		// ½ڵ
-		virtual void OnUpdate(Duration dt) { E2D_NOT_USED(dt); }
+		// δдʱ, ڵк
+		virtual void OnUpdate(Duration dt);
 
 		// Ⱦڵ
 		virtual void OnRender() {}
@@ -288,6 +295,17 @@ namespace easy2d
 			bool enable
 		);
 
+		// Ϊλͼ
+		// ڵ㼰ӽڵƵλͼ, ûб仯ʱֱӻλͼ
+		// ʺݺٱ仯ĸӽڵ, 
+		// ̶ĲֵȾʱʹû
+		void SetCacheAsBitmap(
+			bool enable
+		);
+
+		// Ƿ񻺴Ϊλͼ
+		inline bool IsCacheAsBitmap() const							{ return cache_as_bitmap_; }
+
 		// жϵǷڽڵ
 		bool ContainsPoint(
 			const Point& point
@@ -303,7 +321,7 @@ namespace easy2d
 			Array<NodePtr> const& children
 		);
 
-		// ȡͬӽڵ
+		// ȡͬӽڵ,  Z ˳
 		Array<NodePtr> GetChildren(
 			String const& name
 		) const;
@@ -313,6 +331,24 @@ namespace easy2d
 			String const& name
 		) const;
 
+		// ͬӽڵ
+		// ˳Ϊ˳, вӻƳӽڵ
+		template <typename _Func>
+		void VisitChildren(
+			String const& name,
+			_Func const& func
+		) const
+		{
+			if (Array<Node*> const* children = FindChildren(name))
+			{
+				for (Node* child : *children)
+				{
+					if (child->IsName(name))
+						func(child);
+				}
+			}
+		}
+
 		// ȡȫӽڵ
 		Children const& GetChildren() const;
 
@@ -341,16 +377,121 @@ namespace easy2d
 		inline void PauseUpdating()									{ update_pausing_ = true; }
 
 		// ڵ
-		inline void ResumeUpdating()								{ update_pausing_ = false; }
+		inline void ResumeUpdating()								{ update_pausing_ = false; WakeUp(); }
 
 		// ڵǷͣ
 		inline bool IsUpdatePausing() const							{ return update_pausing_; }
 
 		// øʱĻص
-		inline void SetCallbackOnUpdate(UpdateCallback const& cb)	{ cb_update_ = cb; }
+		void SetCallbackOnUpdate(
+			UpdateCallback const& cb
+		);
+
+		// ѽڵ
+		// ڵ㼰ӽڵûжʱ͸»صʱ, ڵ, ٲ
+		void WakeUp();
+
+		// ڵǷڻ״̬
+		inline bool IsAwake() const									{ return awake_; }
+
+		// Ӷ
+		ActionPtr AddAction(
+			ActionPtr const& action
+		);
+
+		// ȡ
+		ActionPtr GetAction(
+			String const& name
+		);
+
+		// ͣ
+		void ResumeAllActions();
+
+		// ͣж
+		void PauseAllActions();
+
+		// ֹͣж
+		void StopAllActions();
+
+		// ȡж
+		Actions const& GetAllActions() const;
+
+		// Ӷʱ
+		void AddTimer(
+			TimerPtr const& timer
+		);
+
+		// 
+		void StartTimers(
+			String const& timer_name
+		);
+
+		// ֹͣ
+		void StopTimers(
+			String const& timer_name
+		);
+
+		// Ƴ
+		void RemoveTimers(
+			String const& timer_name
+		);
+
+		// 
+		void StartAllTimers();
+
+		// ֹͣ
+		void StopAllTimers();
+
+		// Ƴ
+		void RemoveAllTimers();
+
+		// ȡ
+		Timers const& GetAllTimers() const;
+
+		// Ӽ
+		EventListenerPtr AddListener(
+			EventListenerPtr const& listener
+		);
+
+		// Ӽ
+		void AddListener(
+			UINT type,
+			EventCallback callback,
+			String const& name = L""
+		);
+
+		// 
+		void StartListeners(
+			String const& listener_name
+		);
+
+		// ֹͣ
+		void StopListeners(
+			String const& listener_name
+		);
+
+		// Ƴ
+		void RemoveListeners(
+			String const& listener_name
+		);
+
+		// 
+		void StartListeners(
+			UINT type
+		);
+
+		// ֹͣ
+		void StopListeners(
+			UINT type
+		);
+
+		// Ƴ
+		void RemoveListeners(
+			UINT type
+		);
 
 		// ȡʱĻص
-		inline UpdateCallback const& GetCallbackOnUpdate()			{ return cb_update_; }
+		UpdateCallback const& GetCallbackOnUpdate() const;
 
 		// Ĭê
 		static void SetDefaultAnchor(
@@ -360,43 +501,98 @@ namespace easy2d
 
 	public:
 		// ¼ַ
-		void Dispatch(Event& evt) override;
+		virtual void Dispatch(Event& evt);
 
 	protected:
 		virtual void PrepareRender() {}
 
+		void DispatchListeners(Event& evt);
+
+		Extension& GetExtension() const;
+
 		void Update(Duration dt);
 
+		bool UpdateSelf(Duration dt);
+
 		void Render();
 
+		void RenderSubtree();
+
+		bool RenderCache();
+
+		// ֵȾʱ, ȾλǷɼ
+		bool IsVisibleWhenInterpolated() const;
+
 		void UpdateTransform() const;
 
+		Matrix GetLocalMatrix() const;
+
+		void UpdateBounds();
+
+		void SortChildren();
+
 		void UpdateOpacity();
 
+		void InvalidateTransform();
+
+		void InvalidateBounds();
+
+		// ݸı, ʹýڵλͼʧЧ
+		void InvalidateContent();
+
 		void SetScene(Scene* scene);
 
+		bool IsInParallelPhase() const;
+
+		Array<Node*> const* FindChildren(String const& name) const;
+
+		void IndexChildName(Node* child);
+
+		void UnindexChildName(Node* child);
+
+		void InsertHitProxy();
+
+		void UpdateHitProxy() const;
+
 	protected:
 		bool		visible_;
 		bool		hover_;
 		bool		pressed_;
 		bool		responsible_;
 		bool		update_pausing_;
+		bool		dirty_sort_;
+		bool		dirty_opacity_;
+		bool		awake_;
+		bool		skip_on_update_;
+		bool		parallel_root_;
+		bool		cache_as_bitmap_;
+		bool		dirty_cache_;
 		int			z_order_;
+		int			hit_proxy_;
+		int			transform_slot_;
 		float		opacity_;
 		float		display_opacity_;
 		size_t		hash_name_;
+		unsigned long long z_order_seq_;
 		Transform	transform_;
 		Point		anchor_;
 		Size		size_;
 		Node*		parent_;
 		Scene*		scene_;
 		Children	children_;
-		UpdateCallback cb_update_;
+
+		// , ʱ, Ȳõ, ʹʱŷ
+		mutable std::unique_ptr<Extension> extension_;
+		mutable std::unique_ptr<NameIndex> name_index_;
 
 		mutable bool	dirty_transform_;
 		mutable bool	dirty_transform_inverse_;
+		mutable bool	dirty_bounds_;
+		mutable unsigned int transform_version_;
 		mutable Matrix	transform_matrix_;
-		mutable Matrix	transform_matrix_inverse_;
+
+		bool		infinite_bounds_;
+		Rect		bounds_;
 	};
 
 
@@ -20,21 +20,36 @@
 
 #include "Scene.h"
 #include "../base/logs.h"
+#include "../base/ThreadPool.h"
 #include "../renderer/render.h"
 
 namespace easy2d
 {
+	namespace
+	{
+		// children with at least this many children are expanded into tasks
+		const int parallel_expand_threshold = 16;
+	}
+
 	Scene::Scene()
 		: mouse_cursor_(MouseCursor::Arrow)
 		, last_mouse_cursor(MouseCursor(-1))
+		, parallel_update_enabled_(false)
+		, updating_in_parallel_(false)
 	{
 		scene_ = this;
+		transform_slot_ = transform_cache_.Insert(this, -1);
 
 		SetSize(Renderer::Instance().GetOutputSize());
 	}
 
 	Scene::~Scene()
 	{
+		// children may outlive the scene
+		for (Node* child = children_.First(); child; child = child->NextItem())
+		{
+			child->SetScene(nullptr);
+		}
 	}
 
 	void Scene::OnEnter()
@@ -49,7 +64,16 @@ namespace easy2d
 
 	void Scene::Update(Duration dt)
 	{
-		Node::Update(dt);
+		if (parallel_update_enabled_)
+			UpdateInParallel(dt);
+		else
+			Node::Update(dt);
+
+		// tweens marked by the actions of updated nodes are stepped together
+		tween_system_.Step(dt);
+
+		// recompute all world matrices in one pass before rendering
+		transform_cache_.Update();
 
 		if (last_mouse_cursor != mouse_cursor_)
 		{
@@ -71,6 +95,155 @@ namespace easy2d
 		}
 	}
 
+	void Scene::UpdateInParallel(Duration dt)
+	{
+		if (update_pausing_ || !awake_)
+			return;
+
+		bool busy = UpdateSelf(dt);
+
+		// large containers are updated on this thread, their children become tasks
+		Array<NodePtr> containers;
+		Array<bool> containers_busy;
+
+		SortChildren();
+
+		for (Children::Iterator iter(children_); iter; iter.Next())
+		{
+			Node* child = iter.Get();
+
+			if (child->update_pausing_ || !child->awake_)
+				continue;
+
+			int count = 0;
+			for (auto node = child->children_.First(); node && count < parallel_expand_threshold; node = node->NextItem())
+				++count;
+
+			if (count < parallel_expand_threshold)
+			{
+				parallel_tasks_.push_back(child);
+				continue;
+			}
+
+			containers.push_back(child);
+			containers_busy.push_back(child->UpdateSelf(dt));
+
+			child->SortChildren();
+			for (auto node = child->children_.First(); node; node = node->NextItem())
+			{
+				if (!node->update_pausing_ && node->awake_)
+					parallel_tasks_.push_back(node);
+			}
+		}
+
+		// ancestors of tasks must be valid, workers only compute their own subtrees
+		transform_cache_.Update();
+
+		for (auto const& task : parallel_tasks_)
+			task->parallel_root_ = true;
+
+		// only the parallel phase pays for atomic reference counting
+		updating_in_parallel_ = true;
+		RefCounter::SetThreadSafe(true);
+
+		try
+		{
+			ThreadPool::Instance().ParallelFor(static_cast<int>(parallel_tasks_.size()), [&](int index)
+			{
+				parallel_tasks_[index]->Update(dt);
+			});
+		}
+		catch (...)
+		{
+			RefCounter::SetThreadSafe(false);
+			updating_in_parallel_ = false;
+			for (auto const& task : parallel_tasks_)
+				task->parallel_root_ = false;
+			parallel_tasks_.clear();
+			throw;
+		}
+
+		RefCounter::SetThreadSafe(false);
+		updating_in_parallel_ = false;
+
+		// finish the walks that stopped at task roots
+		for (auto const& task : parallel_tasks_)
+		{
+			task->parallel_root_ = false;
+
+			if (task->dirty_bounds_)
+				task->parent_->InvalidateBounds();
+			else if (task->dirty_cache_)
+				task->parent_->InvalidateContent();
+
+			if (!task->cache_as_bitmap_)
+				task->dirty_cache_ = false;
+		}
+		parallel_tasks_.clear();
+
+		for (size_t i = 0; i < containers.size(); ++i)
+		{
+			Node* container = containers[i].Get();
+
+			bool container_busy = containers_busy[i];
+			for (auto node = container->children_.First(); node; node = node->NextItem())
+			{
+				if (node->awake_)
+					container_busy = true;
+			}
+
+			if (container_busy)
+				container->awake_ = true;
+		}
+
+		for (auto child = children_.First(); child; child = child->NextItem())
+		{
+			if (child->awake_)
+				busy = true;
+		}
+
+		if (busy)
+			awake_ = true;
+
+		FlushDeferred();
+	}
+
+	void Scene::SetParallelUpdateEnabled(bool enabled)
+	{
+		parallel_update_enabled_ = enabled;
+	}
+
+	void Scene::Defer(std::function<void()> const& func)
+	{
+		std::lock_guard<std::mutex> lock(deferred_mutex_);
+		deferred_.push_back(func);
+	}
+
+	void Scene::FlushDeferred()
+	{
+		Array<std::function<void()>> deferred;
+		{
+			std::lock_guard<std::mutex> lock(deferred_mutex_);
+			deferred.swap(deferred_);
+		}
+
+		for (auto const& func : deferred)
+			func();
+	}
+
+	void Scene::Dispatch(Event& evt)
+	{
+		// the index only saves the exact hit tests, the walk itself must visit every node:
+		// all listeners receive every event, hovered nodes outside the cells still need
+		// their MouseOut, and the target is the topmost hit in Z-Order
+		if (evt.type == Event::MouseMove)
+		{
+			hit_index_.Query(Point{ evt.mouse.x, evt.mouse.y });
+		}
+
+		Node::Dispatch(evt);
+	}
+
 	void Scene::SetMouseCursor(MouseCursor cursor)
 	{
 		mouse_cursor_ = cursor;
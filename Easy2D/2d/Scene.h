@@ -20,6 +20,10 @@
 
 #pragma once
 #include "Node.h"
+#include "HitTestIndex.h"
+#include "TransformCache.h"
+#include "TweenSystem.h"
+#include <mutex>
 
 namespace easy2d
 {
@@ -45,8 +49,55 @@ namespace easy2d
 			MouseCursor cursor
 		);
 
+		// ¼ַ
+		void Dispatch(Event& evt) override;
+
+		// ȡ
+		inline HitTestIndex& GetHitTestIndex()	{ return hit_index_; }
+
+		// ȡ任
+		inline TransformCache& GetTransformCache()	{ return transform_cache_; }
+
+		// ȡϵͳ
+		inline TweenSystem& GetTweenSystem()		{ return tween_system_; }
+
+		// òи
+		// ú󳡾ᱻ䵽̳߳ви, ӽڵ϶ӽڵչһ
+		// н׶ OnUpdate, , ʱ͸»صԼ:
+		//   1. ֻܶдǰڵеĽڵ, ޸Ƚڵ
+		//   2. ӻƳӽڵ, ޸ڵƺ Z ˳ᱻӳٵн׶νִ
+		//   3. Դ (ȫֱ, Ƶ, Դ) Ҫм
+		// üֻڲн׶ʹԭӲ, ʱûж⿪
+		void SetParallelUpdateEnabled(
+			bool enabled
+		);
+
+		// Ƿòи
+		inline bool IsParallelUpdateEnabled() const	{ return parallel_update_enabled_; }
+
+		// Ƿڲи½׶
+		inline bool IsUpdatingInParallel() const	{ return updating_in_parallel_; }
+
+		// ӳִ, ڲи½׶ν˳ִ
+		void Defer(
+			std::function<void()> const& func
+		);
+
+	protected:
+		void UpdateInParallel(Duration dt);
+
+		void FlushDeferred();
+
 	protected:
 		MouseCursor mouse_cursor_;
 		MouseCursor last_mouse_cursor;
+		bool parallel_update_enabled_;
+		bool updating_in_parallel_;
+		HitTestIndex hit_index_;
+		TransformCache transform_cache_;
+		TweenSystem tween_system_;
+		Array<NodePtr> parallel_tasks_;
+		Array<std::function<void()>> deferred_;
+		std::mutex deferred_mutex_;
 	};
 }
@@ -58,6 +58,7 @@ namespace easy2d
 			image_ = image;
 
 			Node::SetSize(image_->GetWidth(), image_->GetHeight());
+			InvalidateContent();
 			return true;
 		}
 		return false;
@@ -75,6 +76,7 @@ namespace easy2d
 			if (image_->Load(res))
 			{
 				Node::SetSize(image_->GetWidth(), image_->GetHeight());
+				InvalidateContent();
 				return true;
 			}
 		}
@@ -88,6 +90,7 @@ namespace easy2d
 			std::min(std::max(crop_rect.size.x, 0.f), image_->GetSourceWidth() - image_->GetCropX()),
 			std::min(std::max(crop_rect.size.y, 0.f), image_->GetSourceHeight() - image_->GetCropY())
 		);
+		InvalidateContent();
 	}
 
 	ImagePtr const& Sprite::GetImage() const
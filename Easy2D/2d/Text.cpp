@@ -168,18 +168,21 @@ namespace easy2d
 	{
 		text_ = text;
 		layout_dirty_ = true;
+		InvalidateContent();
 	}
 
 	void Text::SetStyle(const TextStyle& style)
 	{
 		style_ = style;
 		layout_dirty_ = true;
+		InvalidateContent();
 	}
 
 	void Text::SetFont(const Font & font)
 	{
 		font_ = font;
 		layout_dirty_ = true;
+		InvalidateContent();
 	}
 
 	void Text::SetFontFamily(String const& family)
@@ -188,6 +191,7 @@ namespace easy2d
 		{
 			font_.family = family;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -197,6 +201,7 @@ namespace easy2d
 		{
 			font_.size = size;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -206,12 +211,14 @@ namespace easy2d
 		{
 			font_.weight = weight;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
 	void Text::SetColor(Color const& color)
 	{
 		style_.color = color;
+		InvalidateContent();
 	}
 
 	void Text::SetItalic(bool val)
@@ -220,6 +227,7 @@ namespace easy2d
 		{
 			font_.italic = val;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -229,6 +237,7 @@ namespace easy2d
 		{
 			style_.wrap = wrap;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -238,6 +247,7 @@ namespace easy2d
 		{
 			style_.wrap_width = std::max(wrap_width, 0.f);
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -247,6 +257,7 @@ namespace easy2d
 		{
 			style_.line_spacing = line_spacing;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -256,6 +267,7 @@ namespace easy2d
 		{
 			style_.alignment = align;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -265,6 +277,7 @@ namespace easy2d
 		{
 			style_.underline = underline;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
@@ -274,27 +287,32 @@ namespace easy2d
 		{
 			style_.strikethrough = strikethrough;
 			layout_dirty_ = true;
+			InvalidateContent();
 		}
 	}
 
 	void Text::SetOutline(bool outline)
 	{
 		style_.outline = outline;
+		InvalidateContent();
 	}
 
 	void Text::SetOutlineColor(Color const&outline_color)
 	{
 		style_.outline_color = outline_color;
+		InvalidateContent();
 	}
 
 	void Text::SetOutlineWidth(float outline_width)
 	{
 		style_.outline_width = outline_width;
+		InvalidateContent();
 	}
 
 	void Text::SetOutlineStroke(StrokeStyle outline_stroke)
 	{
 		style_.outline_stroke = outline_stroke;
+		InvalidateContent();
 	}
 
 	void Text::OnRender()
@@ -0,0 +1,234 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "TransformCache.h"
+#include "Node.h"
+
+namespace easy2d
+{
+	TransformCache::TransformCache()
+		: dirty_(false)
+		, dirty_layout_(false)
+		, count_(0)
+		, alpha_(1.f)
+		, version_(0)
+	{
+	}
+
+	int TransformCache::Insert(Node* node, int parent)
+	{
+		E2D_ASSERT((parent < 0 || data_.nodes[parent]) && "The parent must be inserted before its children");
+
+		int slot = static_cast<int>(data_.nodes.size());
+		data_.nodes.push_back(node);
+		data_.parents.push_back(parent);
+		data_.dirty_locals.push_back(true);
+		data_.world_versions.push_back(0);
+		data_.parent_versions.push_back(0);
+		data_.locals.push_back(Matrix{});
+		data_.worlds.push_back(Matrix{});
+		data_.saved_worlds.push_back(Matrix{});
+		data_.saved_versions.push_back(0);
+
+		++count_;
+		dirty_ = true;
+		dirty_layout_ = true;
+		return slot;
+	}
+
+	void TransformCache::Remove(int slot)
+	{
+		data_.nodes[slot] = nullptr;
+		data_.parents[slot] = -1;
+
+		--count_;
+		dirty_layout_ = true;
+	}
+
+	void TransformCache::MarkDirty(int slot)
+	{
+		data_.dirty_locals[slot] = true;
+		dirty_ = true;
+	}
+
+	void TransformCache::Validate(int slot)
+	{
+		if (!dirty_)
+			return;
+
+		int parent = data_.parents[slot];
+		if (parent >= 0)
+			Validate(parent);
+
+		if (!IsValid(slot))
+			Compute(slot);
+	}
+
+	void TransformCache::Update()
+	{
+		if (dirty_layout_)
+		{
+			dirty_layout_ = false;
+
+			// rearrange nodes in depth-first order and drop removed slots
+			Columns old;
+			old.Swap(data_);
+			data_.Reserve(static_cast<size_t>(count_));
+
+			for (size_t i = 0; i < old.nodes.size(); ++i)
+			{
+				if (old.nodes[i] && old.parents[i] < 0)
+					Rebuild(old, old.nodes[i], -1);
+			}
+		}
+
+		if (!dirty_)
+			return;
+
+		dirty_ = false;
+
+		// parents are always in front of their children
+		const int count = static_cast<int>(data_.nodes.size());
+		for (int slot = 0; slot < count; ++slot)
+		{
+			if (data_.nodes[slot] && !IsValid(slot))
+				Compute(slot);
+		}
+	}
+
+	void TransformCache::SaveState()
+	{
+		Update();
+
+		data_.saved_worlds = data_.worlds;
+		data_.saved_versions = data_.world_versions;
+	}
+
+	void TransformCache::SetInterpolation(float alpha)
+	{
+		alpha_ = std::min(std::max(alpha, 0.f), 1.f);
+	}
+
+	Matrix TransformCache::GetRenderMatrix(int slot) const
+	{
+		Matrix const& current = data_.worlds[slot];
+		if (alpha_ >= 1.f)
+			return current;
+
+		// versions start from 1, so slots inserted after the save have nothing to blend from
+		unsigned int saved = data_.saved_versions[slot];
+		if (saved == 0 || saved == data_.world_versions[slot])
+			return current;
+
+		Matrix const& prev = data_.saved_worlds[slot];
+		return Matrix(
+			prev._11 + (current._11 - prev._11) * alpha_,
+			prev._12 + (current._12 - prev._12) * alpha_,
+			prev._21 + (current._21 - prev._21) * alpha_,
+			prev._22 + (current._22 - prev._22) * alpha_,
+			prev._31 + (current._31 - prev._31) * alpha_,
+			prev._32 + (current._32 - prev._32) * alpha_
+		);
+	}
+
+	bool TransformCache::IsValid(int slot) const
+	{
+		if (data_.dirty_locals[slot])
+			return false;
+
+		int parent = data_.parents[slot];
+		return parent < 0 || data_.parent_versions[slot] == data_.world_versions[parent];
+	}
+
+	void TransformCache::Compute(int slot)
+	{
+		if (data_.dirty_locals[slot])
+		{
+			data_.dirty_locals[slot] = false;
+			data_.locals[slot] = data_.nodes[slot]->GetLocalMatrix();
+		}
+
+		int parent = data_.parents[slot];
+		if (parent >= 0)
+		{
+			data_.worlds[slot] = data_.locals[slot] * data_.worlds[parent];
+			data_.parent_versions[slot] = data_.world_versions[parent];
+		}
+		else
+		{
+			data_.worlds[slot] = data_.locals[slot];
+		}
+
+		unsigned int version = ++version_;
+		if (version == 0)
+			version = ++version_;
+		data_.world_versions[slot] = version;
+	}
+
+	void TransformCache::Rebuild(Columns const& old, Node* node, int parent)
+	{
+		int from = node->transform_slot_;
+		int slot = static_cast<int>(data_.nodes.size());
+
+		data_.nodes.push_back(node);
+		data_.parents.push_back(parent);
+		data_.dirty_locals.push_back(old.dirty_locals[from]);
+		data_.world_versions.push_back(old.world_versions[from]);
+		data_.parent_versions.push_back(old.parent_versions[from]);
+		data_.locals.push_back(old.locals[from]);
+		data_.worlds.push_back(old.worlds[from]);
+		data_.saved_worlds.push_back(old.saved_worlds[from]);
+		data_.saved_versions.push_back(old.saved_versions[from]);
+
+		node->transform_slot_ = slot;
+
+		for (Node* child = node->children_.First(); child; child = child->NextItem())
+		{
+			if (child->transform_slot_ >= 0)
+				Rebuild(old, child, slot);
+		}
+	}
+
+	void TransformCache::Columns::Swap(Columns& other)
+	{
+		nodes.swap(other.nodes);
+		parents.swap(other.parents);
+		dirty_locals.swap(other.dirty_locals);
+		world_versions.swap(other.world_versions);
+		parent_versions.swap(other.parent_versions);
+		locals.swap(other.locals);
+		worlds.swap(other.worlds);
+		saved_worlds.swap(other.saved_worlds);
+		saved_versions.swap(other.saved_versions);
+	}
+
+	void TransformCache::Columns::Reserve(size_t count)
+	{
+		nodes.reserve(count);
+		parents.reserve(count);
+		dirty_locals.reserve(count);
+		world_versions.reserve(count);
+		parent_versions.reserve(count);
+		locals.reserve(count);
+		worlds.reserve(count);
+		saved_worlds.reserve(count);
+		saved_versions.reserve(count);
+	}
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "include-forwards.h"
+#include <atomic>
+
+namespace easy2d
+{
+	class Node;
+
+	// 任
+	// ˳洢нڵľֲ,
+	// ڵλӽڵ֮ǰ, һԱи
+	class E2D_API TransformCache
+	{
+	public:
+		TransformCache();
+
+		// ӽڵ, ڵѾڻ
+		int Insert(
+			Node* node,
+			int parent
+		);
+
+		// Ƴڵ
+		void Remove(
+			int slot
+		);
+
+		// ǽڵľֲ任޸
+		void MarkDirty(
+			int slot
+		);
+
+		// µڵ㼰ȵ
+		void Validate(
+			int slot
+		);
+
+		// нڵ, Ҫʱ˳
+		void Update();
+
+		// нڵ㵱ǰ, ڹ̶ÿθǰ
+		void SaveState();
+
+		// ȾʱĲֵϵ, Χ [0, 1], 1 ʾֱʹµ״̬
+		void SetInterpolation(
+			float alpha
+		);
+
+		// ȡȾʹõ
+		// ڱ״̬״ֵ̬֮, ûиıĽڵֱʹµ״̬
+		Matrix GetRenderMatrix(
+			int slot
+		) const;
+
+		// ȾʱǷθµ״ֵ̬֮
+		inline bool IsInterpolating() const						{ return alpha_ < 1.f; }
+
+		// ȡ
+		inline Matrix const& GetWorldMatrix(int slot) const		{ return data_.worlds[slot]; }
+
+		// ȡİ汾, ÿ¼ʱı
+		inline unsigned int GetWorldVersion(int slot) const		{ return data_.world_versions[slot]; }
+
+		// ȡڵ
+		inline int GetCount() const								{ return count_; }
+
+	private:
+		struct Columns
+		{
+			Array<Node*>			nodes;
+			Array<int>				parents;
+			Array<bool>				dirty_locals;
+			Array<unsigned int>		world_versions;
+			Array<unsigned int>		parent_versions;
+			Array<Matrix>			locals;
+			Array<Matrix>			worlds;
+			Array<Matrix>			saved_worlds;
+			Array<unsigned int>		saved_versions;
+
+			void Swap(Columns& other);
+
+			void Reserve(size_t count);
+		};
+
+		bool IsValid(int slot) const;
+
+		void Compute(int slot);
+
+		void Rebuild(Columns const& old, Node* node, int parent);
+
+	private:
+		std::atomic<bool>			dirty_;
+		bool						dirty_layout_;
+		int							count_;
+		float						alpha_;
+		std::atomic<unsigned int>	version_;
+		Columns						data_;
+	};
+}
@@ -0,0 +1,466 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "TweenSystem.h"
+#include "Node.h"
+#include "../base/Trace.h"
+
+namespace easy2d
+{
+	//-------------------------------------------------------
+	// TweenSystem::Track
+	//-------------------------------------------------------
+
+	TweenSystem::Track::Track()
+		: removed(0)
+	{
+	}
+
+	void TweenSystem::Track::Push(ActionTween* tween, Node* target, EaseFunc const* ease, float elapsed_in_loop, float duration, TweenState const& state)
+	{
+		owners.push_back(tween);
+		targets.push_back(target);
+		eases.push_back(ease);
+		ease_types.push_back(ease->GetType());
+		ease_params.push_back(ease->GetParam());
+		ease_tables.push_back(ease->GetTable());
+		actives.push_back(false);
+		elapsed.push_back(elapsed_in_loop);
+		durations.push_back(duration);
+		percents.push_back(0.f);
+		start_x.push_back(state.start.x);
+		start_y.push_back(state.start.y);
+		delta_x.push_back(state.delta.x);
+		delta_y.push_back(state.delta.y);
+		prev_x.push_back(state.prev.x);
+		prev_y.push_back(state.prev.y);
+		value_x.push_back(0.f);
+		value_y.push_back(0.f);
+	}
+
+	void TweenSystem::Track::Move(size_t from, size_t to)
+	{
+		owners[to] = owners[from];
+		targets[to] = targets[from];
+		eases[to] = eases[from];
+		ease_types[to] = ease_types[from];
+		ease_params[to] = ease_params[from];
+		ease_tables[to] = ease_tables[from];
+		actives[to] = actives[from];
+		elapsed[to] = elapsed[from];
+		durations[to] = durations[from];
+		start_x[to] = start_x[from];
+		start_y[to] = start_y[from];
+		delta_x[to] = delta_x[from];
+		delta_y[to] = delta_y[from];
+		prev_x[to] = prev_x[from];
+		prev_y[to] = prev_y[from];
+	}
+
+	void TweenSystem::Track::PopBack()
+	{
+		const size_t count = owners.size() - 1;
+		owners.resize(count);
+		targets.resize(count);
+		eases.resize(count);
+		ease_types.resize(count);
+		ease_params.resize(count);
+		ease_tables.resize(count);
+		actives.resize(count);
+		elapsed.resize(count);
+		durations.resize(count);
+		percents.resize(count);
+		start_x.resize(count);
+		start_y.resize(count);
+		delta_x.resize(count);
+		delta_y.resize(count);
+		prev_x.resize(count);
+		prev_y.resize(count);
+		value_x.resize(count);
+		value_y.resize(count);
+	}
+
+	void TweenSystem::Track::Load(size_t slot, TweenState const& state)
+	{
+		start_x[slot] = state.start.x;
+		start_y[slot] = state.start.y;
+		delta_x[slot] = state.delta.x;
+		delta_y[slot] = state.delta.y;
+		prev_x[slot] = state.prev.x;
+		prev_y[slot] = state.prev.y;
+	}
+
+	void TweenSystem::Track::Save(size_t slot, TweenState& state) const
+	{
+		state.start = Point(start_x[slot], start_y[slot]);
+		state.delta = Point(delta_x[slot], delta_y[slot]);
+		state.prev = Point(prev_x[slot], prev_y[slot]);
+	}
+
+
+	//-------------------------------------------------------
+	// TweenSystem
+	//-------------------------------------------------------
+
+	TweenSystem::TweenSystem()
+	{
+	}
+
+	TweenSystem::~TweenSystem()
+	{
+		while (!pending_.empty())
+		{
+			Remove(pending_.back().tween);
+		}
+
+		for (auto& track : tracks_)
+		{
+			for (size_t i = 0; i < track.owners.size(); ++i)
+			{
+				if (track.owners[i])
+					Remove(track.owners[i]);
+			}
+		}
+	}
+
+	void TweenSystem::Add(ActionTween* tween, Node* target)
+	{
+		E2D_ASSERT(tween && target && !tween->tween_system_ && tween->property_ != TweenProperty::None);
+
+		tween->Retain();
+		tween->tween_system_ = this;
+		tween->tween_slot_ = -1;
+		tween->batched_ = true;
+
+		std::lock_guard<std::mutex> lock(pending_mutex_);
+		pending_.push_back(Pending{ tween, target });
+	}
+
+	void TweenSystem::Remove(ActionTween* tween)
+	{
+		E2D_ASSERT(tween && tween->tween_system_ == this);
+
+		if (tween->tween_slot_ < 0)
+		{
+			std::lock_guard<std::mutex> lock(pending_mutex_);
+			for (size_t i = 0; i < pending_.size(); ++i)
+			{
+				if (pending_[i].tween == tween)
+				{
+					pending_[i] = pending_.back();
+					pending_.pop_back();
+					break;
+				}
+			}
+		}
+		else
+		{
+			// the slot is released in the next Step, workers may still be marking other slots
+			Track& track = tracks_[static_cast<int>(tween->property_)];
+			const size_t slot = static_cast<size_t>(tween->tween_slot_);
+
+			TweenState state;
+			track.Save(slot, state);
+			tween->LoadTweenState(state);
+
+			track.owners[slot] = nullptr;
+			track.targets[slot] = nullptr;
+			track.actives[slot] = false;
+			++track.removed;
+		}
+
+		tween->tween_system_ = nullptr;
+		tween->tween_slot_ = -1;
+		tween->batched_ = false;
+		tween->Release();
+	}
+
+	void TweenSystem::UpdateEase(ActionTween* tween)
+	{
+		E2D_ASSERT(tween && tween->tween_system_ == this);
+
+		// pending tweens read the ease when they are flushed
+		if (tween->tween_slot_ < 0)
+			return;
+
+		Track& track = tracks_[static_cast<int>(tween->property_)];
+		const size_t slot = static_cast<size_t>(tween->tween_slot_);
+
+		track.ease_types[slot] = tween->ease_func_.GetType();
+		track.ease_params[slot] = tween->ease_func_.GetParam();
+		track.ease_tables[slot] = tween->ease_func_.GetTable();
+	}
+
+	void TweenSystem::Step(Duration dt)
+	{
+		E2D_PROFILE_SCOPE("TweenSystem::Step");
+
+		const float seconds = dt.Seconds();
+		for (auto& track : tracks_)
+		{
+			Compact(track);
+			Advance(track, seconds);
+		}
+
+		// tweens bound in this frame have been updated by their actions already
+		Flush();
+
+		for (int i = 0; i < static_cast<int>(TweenProperty::Count); ++i)
+		{
+			Track& track = tracks_[i];
+			Evaluate(track, static_cast<TweenProperty>(i));
+			Complete(track);
+
+			bool* actives = track.actives.begin();
+			for (size_t j = 0, count = track.actives.size(); j < count; ++j)
+				actives[j] = false;
+		}
+	}
+
+	int TweenSystem::GetCount() const
+	{
+		int count = 0;
+		for (auto const& track : tracks_)
+			count += static_cast<int>(track.owners.size()) - track.removed;
+		return count;
+	}
+
+	void TweenSystem::Compact(Track& track)
+	{
+		if (track.removed == 0)
+			return;
+
+		size_t count = track.owners.size();
+		for (size_t i = 0; i < count;)
+		{
+			if (track.owners[i])
+			{
+				++i;
+				continue;
+			}
+
+			--count;
+			if (i != count)
+			{
+				track.Move(count, i);
+				if (track.owners[i])
+					track.owners[i]->tween_slot_ = static_cast<int>(i);
+			}
+			track.PopBack();
+		}
+		track.removed = 0;
+	}
+
+	void TweenSystem::Flush()
+	{
+		std::lock_guard<std::mutex> lock(pending_mutex_);
+
+		for (auto const& pending : pending_)
+		{
+			ActionTween* tween = pending.tween;
+			Track& track = tracks_[static_cast<int>(tween->property_)];
+
+			TweenState state;
+			tween->SaveTweenState(state);
+
+			const Duration elapsed = tween->elapsed_ - tween->delay_ - tween->dur_ * tween->loops_done_;
+
+			tween->tween_slot_ = static_cast<int>(track.owners.size());
+			track.Push(tween, pending.target, &tween->ease_func_, std::max(elapsed.Seconds(), 0.f), tween->dur_.Seconds(), state);
+		}
+		pending_.resize(0);
+	}
+
+	void TweenSystem::Advance(Track& track, float dt)
+	{
+		const size_t count = track.owners.size();
+		const bool* actives = track.actives.begin();
+		float* elapsed = track.elapsed.begin();
+
+		for (size_t i = 0; i < count; ++i)
+			elapsed[i] += actives[i] ? dt : 0.f;
+	}
+
+	void TweenSystem::Evaluate(Track& track, TweenProperty property)
+	{
+		const size_t count = track.owners.size();
+		if (count == 0)
+			return;
+
+		const bool* actives = track.actives.begin();
+		const float* elapsed = track.elapsed.begin();
+		const float* durations = track.durations.begin();
+		float* percents = track.percents.begin();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float percent = durations[i] > 0.f ? elapsed[i] / durations[i] : 1.f;
+			percents[i] = percent < 1.f ? percent : 1.f;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (actives[i] && percents[i] >= 1.f)
+				finished_.push_back(static_cast<int>(i));
+		}
+
+		// built-in curves and tables are evaluated inline, only custom functions go through the action
+		EaseFunc const* const* eases = track.eases.begin();
+		const EaseType* ease_types = track.ease_types.begin();
+		const float* ease_params = track.ease_params.begin();
+		Array<float> const* const* ease_tables = track.ease_tables.begin();
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (!actives[i])
+				continue;
+
+			switch (ease_types[i])
+			{
+			case EaseType::None:
+				break;
+			case EaseType::Table:
+				percents[i] = EaseFunc::SampleTable(ease_tables[i]->begin(), ease_tables[i]->size(), percents[i]);
+				break;
+			case EaseType::Custom:
+				percents[i] = (*eases[i])(percents[i]);
+				break;
+			default:
+				percents[i] = EaseFunc::Evaluate(ease_types[i], ease_params[i], percents[i]);
+				break;
+			}
+		}
+
+		Node* const* targets = track.targets.begin();
+		float* start_x = track.start_x.begin();
+		float* start_y = track.start_y.begin();
+		const float* delta_x = track.delta_x.begin();
+		const float* delta_y = track.delta_y.begin();
+		float* value_x = track.value_x.begin();
+		float* value_y = track.value_y.begin();
+
+		switch (property)
+		{
+		case TweenProperty::Position:
+		{
+			// moving the node outside the action shifts the path, like ActionMoveBy::UpdateTween
+			float* prev_x = track.prev_x.begin();
+			float* prev_y = track.prev_y.begin();
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (!actives[i])
+					continue;
+
+				Point const& pos = targets[i]->GetPosition();
+				start_x[i] += pos.x - prev_x[i];
+				start_y[i] += pos.y - prev_y[i];
+
+				prev_x[i] = start_x[i] + delta_x[i] * percents[i];
+				prev_y[i] = start_y[i] + delta_y[i] * percents[i];
+				targets[i]->SetPosition(prev_x[i], prev_y[i]);
+			}
+			break;
+		}
+
+		case TweenProperty::Scale:
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				value_x[i] = start_x[i] + delta_x[i] * percents[i];
+				value_y[i] = start_y[i] + delta_y[i] * percents[i];
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (actives[i])
+					targets[i]->SetScale(value_x[i], value_y[i]);
+			}
+			break;
+		}
+
+		case TweenProperty::Rotation:
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float rotation = start_x[i] + delta_x[i] * percents[i];
+				value_x[i] = rotation > 360.f ? rotation - 360.f : rotation;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (actives[i])
+					targets[i]->SetRotation(value_x[i]);
+			}
+			break;
+		}
+
+		case TweenProperty::Opacity:
+		{
+			for (size_t i = 0; i < count; ++i)
+				value_x[i] = start_x[i] + delta_x[i] * percents[i];
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (actives[i])
+					targets[i]->SetOpacity(value_x[i]);
+			}
+			break;
+		}
+		}
+	}
+
+	void TweenSystem::Complete(Track& track)
+	{
+		if (finished_.empty())
+			return;
+
+		for (size_t i = 0; i < finished_.size(); ++i)
+		{
+			const size_t slot = static_cast<size_t>(finished_[i]);
+
+			// callbacks may remove the tween or its target
+			ActionTweenPtr tween = track.owners[slot];
+			if (!tween)
+				continue;
+
+			NodePtr target = track.targets[slot];
+
+			tween->Complete(target);	// loops_done_++
+			if (tween->status_ == Action::Status::Done)
+				tween->Finish(target);
+
+			if (track.owners[slot] != tween.Get())
+				continue;
+
+			if (tween->IsRemoveable())
+			{
+				Remove(tween.Get());
+				continue;
+			}
+
+			// next loop, start values are captured again in Init
+			TweenState state;
+			tween->SaveTweenState(state);
+			track.Load(slot, state);
+			track.elapsed[slot] = std::max(track.elapsed[slot] - track.durations[slot], 0.f);
+		}
+		finished_.resize(0);
+	}
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "ActionTween.h"
+#include <atomic>
+#include <mutex>
+
+namespace easy2d
+{
+	// ϵͳ
+	// Է, 洢µĲ䶯,
+	// ڽڵ½ͳһƽʱ, 㻺ֵ, дؽڵ
+	class E2D_API TweenSystem
+	{
+	public:
+		TweenSystem();
+
+		~TweenSystem();
+
+		// Ӳ䶯, һ Step ʱ, ڲи½׶ε
+		void Add(
+			ActionTween* tween,
+			Node* target
+		);
+
+		// Ƴ䶯, ״̬дض
+		void Remove(
+			ActionTween* tween
+		);
+
+		// Ļ޸ĺ
+		void UpdateEase(
+			ActionTween* tween
+		);
+
+		// ǲ䶯ڱ֡Ҫ, ɽڵĶڸʱ
+		inline void MarkActive(ActionTween* tween)
+		{
+			if (tween->tween_slot_ >= 0)
+				tracks_[static_cast<int>(tween->property_)].actives.begin()[tween->tween_slot_] = true;
+		}
+
+		// ±֡ǹĲ䶯
+		void Step(
+			Duration dt
+		);
+
+		// ȡ䶯
+		int GetCount() const;
+
+	private:
+		struct Track
+		{
+			Array<ActionTween*>		owners;
+			Array<Node*>			targets;
+			Array<EaseFunc const*>	eases;
+			Array<EaseType>			ease_types;
+			Array<float>			ease_params;
+			Array<Array<float> const*>	ease_tables;
+			Array<bool>				actives;
+			Array<float>			elapsed;
+			Array<float>			durations;
+			Array<float>			percents;
+			Array<float>			start_x;
+			Array<float>			start_y;
+			Array<float>			delta_x;
+			Array<float>			delta_y;
+			Array<float>			prev_x;
+			Array<float>			prev_y;
+			Array<float>			value_x;
+			Array<float>			value_y;
+			std::atomic<int>		removed;
+
+			Track();
+
+			void Push(ActionTween* tween, Node* target, EaseFunc const* ease, float elapsed_in_loop, float duration, TweenState const& state);
+
+			void Move(size_t from, size_t to);
+
+			void PopBack();
+
+			void Load(size_t slot, TweenState const& state);
+
+			void Save(size_t slot, TweenState& state) const;
+		};
+
+		struct Pending
+		{
+			ActionTween*	tween;
+			Node*			target;
+		};
+
+		void Compact(Track& track);
+
+		void Flush();
+
+		void Advance(Track& track, float dt);
+
+		void Evaluate(Track& track, TweenProperty property);
+
+		void Complete(Track& track);
+
+	private:
+		Track			tracks_[static_cast<int>(TweenProperty::Count)];
+		Array<Pending>	pending_;
+		std::mutex		pending_mutex_;
+		Array<int>		finished_;
+	};
+}
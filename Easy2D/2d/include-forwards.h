@@ -25,6 +25,7 @@
 #include "../common/Closure.hpp"
 #include "../common/Singleton.hpp"
 #include "../common/IntrusiveList.hpp"
+#include "../common/IntrusiveRawList.hpp"
 #include "../base/time.h"
 #include "../base/RefCounter.hpp"
 #include "../base/SmartPtr.hpp"
@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include "AsyncTask.h"
+#include "Trace.h"
 #include "../common/closure.hpp"
 #include "../platform/Application.h"
 #include <thread>
@@ -62,6 +63,8 @@ namespace easy2d
 
 	void AsyncTask::TaskThread()
 	{
+		E2D_PROFILE_SCOPE("AsyncTask::TaskThread");
+
 		while (!thread_func_queue_.empty())
 		{
 			auto& func = thread_func_queue_.front();
@@ -20,18 +20,20 @@
 
 #include "EventDispatcher.h"
 #include "../base/logs.h"
+#include "../base/Trace.h"
 
 namespace easy2d
 {
 	void EventDispatcher::Dispatch(Event& evt)
 	{
+		E2D_PROFILE_SCOPE("EventDispatcher::Dispatch");
+
 		if (listeners_.IsEmpty())
 			return;
 
-		EventListenerPtr next;
-		for (auto listener = listeners_.First(); listener; listener = next)
+		for (Listeners::Iterator iter(listeners_); iter; iter.Next())
 		{
-			next = listener->NextItem();
+			EventListener* listener = iter.Get();
 
 			if (listener->type_ == evt.type)
 			{
@@ -46,7 +48,7 @@ namespace easy2d
 
 		if (listener)
 		{
-			listeners_.PushBack(listener);
+			listeners_.PushBack(listener.Get());
 		}
 		return listener;
 	}
@@ -56,7 +58,7 @@ namespace easy2d
 		EventListenerPtr listener = new EventListener(type, callback, name);
 		if (listener)
 		{
-			listeners_.PushBack(listener);
+			listeners_.PushBack(listener.Get());
 		}
 	}
 
@@ -84,7 +86,7 @@ namespace easy2d
 
 	void EventDispatcher::RemoveListeners(String const & listener_name)
 	{
-		EventListenerPtr next;
+		EventListener* next;
 		for (auto listener = listeners_.First(); listener; listener = next)
 		{
 			next = listener->NextItem();
@@ -120,7 +122,7 @@ namespace easy2d
 
 	void EventDispatcher::RemoveListeners(UINT type)
 	{
-		EventListenerPtr next;
+		EventListener* next;
 		for (auto listener = listeners_.First(); listener; listener = next)
 		{
 			next = listener->NextItem();
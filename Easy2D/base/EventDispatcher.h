@@ -25,7 +25,7 @@ namespace easy2d
 {
 	class E2D_API EventDispatcher
 	{
-		using Listeners = IntrusiveList<EventListenerPtr>;
+		using Listeners = IntrusiveRawList<EventListener>;
 
 	public:
 		// Ӽ
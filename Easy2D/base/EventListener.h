@@ -21,7 +21,7 @@
 #pragma once
 #include "../base/SmartPtr.hpp"
 #include "../common/helper.h"
-#include "../common/IntrusiveList.hpp"
+#include "../common/IntrusiveRawList.hpp"
 #include "Object.h"
 #include "Event.hpp"
 #include <functional>
@@ -37,10 +37,10 @@ namespace easy2d
 	// ¼
 	class E2D_API EventListener
 		: public virtual Object
-		, protected IntrusiveListItem<EventListenerPtr>
+		, protected IntrusiveRawListItem<EventListener>
 	{
 		friend class EventDispatcher;
-		friend class IntrusiveList<EventListenerPtr>;
+		friend class IntrusiveRawList<EventListener>;
 
 	public:
 		EventListener(
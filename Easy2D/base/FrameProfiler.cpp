@@ -0,0 +1,228 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "FrameProfiler.h"
+#include "../base/logs.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace easy2d
+{
+	namespace
+	{
+		const int default_history_size = 600;
+
+		// nearest-rank percentile of sorted samples
+		inline float Percentile(Array<float> const& sorted, float p)
+		{
+			int rank = static_cast<int>(std::ceil(p * static_cast<float>(sorted.size()))) - 1;
+			rank = std::min(std::max(rank, 0), static_cast<int>(sorted.size()) - 1);
+			return sorted[rank];
+		}
+	}
+
+	FrameProfiler::FrameProfiler()
+		: enabled_(false)
+		, in_frame_(false)
+		, history_size_(0)
+		, frame_count_(0)
+		, cursor_(0)
+		, frequency_(0)
+	{
+		LARGE_INTEGER freq;
+		::QueryPerformanceFrequency(&freq);
+		frequency_ = static_cast<double>(freq.QuadPart) / 1000.0;
+
+		SetHistorySize(default_history_size);
+	}
+
+	FrameProfiler::~FrameProfiler()
+	{
+	}
+
+	void FrameProfiler::SetEnabled(bool enabled)
+	{
+		enabled_ = enabled;
+		in_frame_ = false;
+	}
+
+	void FrameProfiler::SetHistorySize(int frames)
+	{
+		E2D_ASSERT(frames > 0 && "History size must be positive");
+
+		history_size_ = std::max(frames, 1);
+		history_.resize(history_size_ * phase_count);
+		Reset();
+	}
+
+	void FrameProfiler::Reset()
+	{
+		frame_count_ = 0;
+		cursor_ = 0;
+		in_frame_ = false;
+
+		for (int i = 0; i < phase_count; ++i)
+		{
+			phase_start_[i] = 0;
+			current_[i] = 0.f;
+			last_[i] = 0.f;
+		}
+	}
+
+	void FrameProfiler::BeginFrame()
+	{
+		if (!enabled_)
+			return;
+
+		for (int i = 0; i < phase_count; ++i)
+			current_[i] = 0.f;
+
+		in_frame_ = true;
+		BeginPhase(FramePhase::Frame);
+	}
+
+	void FrameProfiler::EndFrame()
+	{
+		// frames interrupted by an exception or by enabling the profiler mid-frame are dropped
+		if (!enabled_ || !in_frame_)
+			return;
+
+		EndPhase(FramePhase::Frame);
+		in_frame_ = false;
+
+		for (int i = 0; i < phase_count; ++i)
+		{
+			last_[i] = current_[i];
+			history_[i * history_size_ + cursor_] = current_[i];
+		}
+
+		cursor_ = (cursor_ + 1) % history_size_;
+		frame_count_ = std::min(frame_count_ + 1, history_size_);
+	}
+
+	void FrameProfiler::BeginPhase(FramePhase phase)
+	{
+		if (!enabled_)
+			return;
+
+		phase_start_[static_cast<int>(phase)] = Now();
+	}
+
+	void FrameProfiler::EndPhase(FramePhase phase)
+	{
+		if (!enabled_)
+			return;
+
+		const int index = static_cast<int>(phase);
+		current_[index] += static_cast<float>(Now() - phase_start_[index]);
+	}
+
+	float FrameProfiler::GetLastDuration(FramePhase phase) const
+	{
+		return last_[static_cast<int>(phase)];
+	}
+
+	FrameProfiler::PhaseStats FrameProfiler::GetStats(FramePhase phase) const
+	{
+		PhaseStats stats = {};
+		if (frame_count_ == 0)
+			return stats;
+
+		// the ring is full or filled from the start, so the first frame_count_ samples are valid
+		const float* samples = &history_[static_cast<int>(phase) * history_size_];
+		sorted_.assign(samples, samples + frame_count_);
+		std::sort(sorted_.begin(), sorted_.end());
+
+		double sum = 0;
+		for (float sample : sorted_)
+			sum += sample;
+
+		stats.samples = frame_count_;
+		stats.average = static_cast<float>(sum / frame_count_);
+		stats.p50 = Percentile(sorted_, 0.50f);
+		stats.p95 = Percentile(sorted_, 0.95f);
+		stats.p99 = Percentile(sorted_, 0.99f);
+		stats.max = sorted_.back();
+		return stats;
+	}
+
+	String FrameProfiler::ToJSON() const
+	{
+		StringStream ss;
+		ss << std::fixed << std::setprecision(3);
+		ss << L"{\n\t\"frames\": " << frame_count_ << L",\n\t\"phases\": {";
+
+		for (int i = 0; i < phase_count; ++i)
+		{
+			PhaseStats stats = GetStats(static_cast<FramePhase>(i));
+
+			ss << (i ? L",\n" : L"\n")
+				<< L"\t\t\"" << GetPhaseName(static_cast<FramePhase>(i)) << L"\": { "
+				<< L"\"samples\": " << stats.samples
+				<< L", \"average\": " << stats.average
+				<< L", \"p50\": " << stats.p50
+				<< L", \"p95\": " << stats.p95
+				<< L", \"p99\": " << stats.p99
+				<< L", \"max\": " << stats.max
+				<< L" }";
+		}
+
+		ss << L"\n\t}\n}\n";
+		return ss.str();
+	}
+
+	bool FrameProfiler::SaveToFile(String const& file_path) const
+	{
+		std::wofstream file(file_path.c_str());
+		if (!file)
+		{
+			E2D_WARNING_LOG(L"Failed to open profile file: %s", file_path.c_str());
+			return false;
+		}
+
+		file << ToJSON();
+		return static_cast<bool>(file);
+	}
+
+	wchar_t const* FrameProfiler::GetPhaseName(FramePhase phase)
+	{
+		switch (phase)
+		{
+		case FramePhase::Transition:	return L"transition";
+		case FramePhase::Functions:		return L"functions";
+		case FramePhase::SceneUpdate:	return L"scene_update";
+		case FramePhase::Input:			return L"input";
+		case FramePhase::Traversal:		return L"traversal";
+		case FramePhase::Submit:		return L"submit";
+		case FramePhase::Present:		return L"present";
+		case FramePhase::Frame:			return L"frame";
+		default:						return L"unknown";
+		}
+	}
+
+	double FrameProfiler::Now() const
+	{
+		LARGE_INTEGER count;
+		::QueryPerformanceCounter(&count);
+		return static_cast<double>(count.QuadPart) / frequency_;
+	}
+}
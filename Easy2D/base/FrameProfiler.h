@@ -0,0 +1,142 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../common/helper.h"
+#include "../common/Singleton.hpp"
+
+namespace easy2d
+{
+	// ֡׶
+	enum class FramePhase : int
+	{
+		Transition,		// 
+		Functions,		// ̺߳
+		SceneUpdate,	// 
+		Input,			// ״̬
+		Traversal,		// ڵ, ¼
+		Submit,			// ִл
+		Present,		// , ȴֱͬ
+		Frame,			// ֡
+
+		Count
+	};
+
+
+	// ܷ֡
+	// ¼ÿ֡׶εĺʱ, ֡ʷ, ͳƷλԶع
+	class E2D_API FrameProfiler
+		: public Singleton<FrameProfiler>
+	{
+		E2D_DECLARE_SINGLETON(FrameProfiler);
+
+	public:
+		// ׶κʱͳ, λΪ
+		struct PhaseStats
+		{
+			int		samples;	// 
+			float	average;
+			float	p50;
+			float	p95;
+			float	p99;
+			float	max;
+		};
+
+		// رշ, ĬϹر
+		void SetEnabled(
+			bool enabled
+		);
+
+		// ñʷ֡, 
+		void SetHistorySize(
+			int frames
+		);
+
+		// ʷ
+		void Reset();
+
+		void BeginFrame();
+
+		void EndFrame();
+
+		// ׶οһ֡ڶν, ʱۼ
+		void BeginPhase(
+			FramePhase phase
+		);
+
+		void EndPhase(
+			FramePhase phase
+		);
+
+		// ȡһ֡ĳ׶εĺʱ ()
+		float GetLastDuration(
+			FramePhase phase
+		) const;
+
+		// ͳʷĳ׶εĺʱ
+		PhaseStats GetStats(
+			FramePhase phase
+		) const;
+
+		// н׶εͳΪ JSON
+		String ToJSON() const;
+
+		//  JSON ļ
+		bool SaveToFile(
+			String const& file_path
+		) const;
+
+		static wchar_t const* GetPhaseName(
+			FramePhase phase
+		);
+
+		inline bool IsEnabled() const			{ return enabled_; }
+
+		inline int GetHistorySize() const		{ return history_size_; }
+
+		// ʷе֡
+		inline int GetFrameCount() const		{ return frame_count_; }
+
+	private:
+		FrameProfiler();
+
+		~FrameProfiler();
+
+		// ǰʱ ()
+		double Now() const;
+
+	private:
+		static const int phase_count = static_cast<int>(FramePhase::Count);
+
+		bool	enabled_;
+		bool	in_frame_;
+		int		history_size_;
+		int		frame_count_;
+		int		cursor_;
+		double	frequency_;
+		double	phase_start_[phase_count];
+		float	current_[phase_count];
+		float	last_[phase_count];
+
+		// ÿ׶ history_size_ , δ洢
+		Array<float>			history_;
+		mutable Array<float>	sorted_;
+	};
+}
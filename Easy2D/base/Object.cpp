@@ -19,8 +19,10 @@
 // THE SOFTWARE.
 
 #include "Object.h"
+#include "ObjectPool.h"
 #include "logs.h"
 #include <typeinfo>
+#include <mutex>
 
 namespace easy2d
 {
@@ -28,9 +30,10 @@ namespace easy2d
 	{
 		bool tracing_leaks = false;
 		Array<Object*> tracing_objects;
+		std::mutex tracing_mutex;
 	}
 
-	unsigned int Object::last_object_id = 0;
+	std::atomic<unsigned int> Object::last_object_id(0);
 
 	Object::Object()
 		: tracing_leak_(false)
@@ -57,6 +60,33 @@ namespace easy2d
 #endif
 	}
 
+	void* Object::operator new(size_t size)
+	{
+		return ObjectPool::Allocate(size);
+	}
+
+	void* Object::operator new(size_t size, std::nothrow_t const&) E2D_NOEXCEPT
+	{
+		try
+		{
+			return ObjectPool::Allocate(size);
+		}
+		catch (...)
+		{
+			return nullptr;
+		}
+	}
+
+	void Object::operator delete(void* ptr)
+	{
+		ObjectPool::Deallocate(ptr);
+	}
+
+	void Object::operator delete(void* ptr, std::nothrow_t const&) E2D_NOEXCEPT
+	{
+		ObjectPool::Deallocate(ptr);
+	}
+
 	void * Object::GetUserData() const
 	{
 		return user_data_;
@@ -126,6 +156,7 @@ namespace easy2d
 
 		if (tracing_leaks && !obj->tracing_leak_)
 		{
+			std::lock_guard<std::mutex> lock(tracing_mutex);
 			obj->tracing_leak_ = true;
 			tracing_objects.push_back(obj);
 		}
@@ -139,6 +170,7 @@ namespace easy2d
 
 		if (tracing_leaks && obj->tracing_leak_)
 		{
+			std::lock_guard<std::mutex> lock(tracing_mutex);
 			obj->tracing_leak_ = false;
 
 			auto iter = std::find(tracing_objects.begin(), tracing_objects.end(), obj);
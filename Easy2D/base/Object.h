@@ -23,6 +23,8 @@
 #include "../common/helper.h"
 #include "RefCounter.hpp"
 #include "SmartPtr.hpp"
+#include <atomic>
+#include <new>
 
 namespace easy2d
 {
@@ -50,6 +52,16 @@ namespace easy2d
 
 		String DumpObject();
 
+	public:
+		// ڴ ObjectPool з
+		static void* operator new(size_t size);
+
+		static void* operator new(size_t size, std::nothrow_t const&) E2D_NOEXCEPT;
+
+		static void operator delete(void* ptr);
+
+		static void operator delete(void* ptr, std::nothrow_t const&) E2D_NOEXCEPT;
+
 	public:
 		static void StartTracingLeaks();
 
@@ -70,6 +82,6 @@ namespace easy2d
 		String* name_;
 
 		const unsigned int id_;
-		static unsigned int last_object_id;
+		static std::atomic<unsigned int> last_object_id;
 	};
 }
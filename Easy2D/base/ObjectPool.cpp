@@ -0,0 +1,207 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ObjectPool.h"
+#include "logs.h"
+#include <atomic>
+#include <mutex>
+#include <cstddef>
+
+namespace easy2d
+{
+	namespace
+	{
+		const size_t block_granularity = 16;
+		const size_t max_block_size = 1024;
+		const size_t size_class_count = max_block_size / block_granularity;
+		const size_t chunk_size = 64 * 1024;
+		const int oversized_class = -1;
+
+		// stored in front of every block, so that Deallocate() needs no size
+		union BlockHeader
+		{
+			int				size_class;
+			std::max_align_t align;
+		};
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct SizeClass
+		{
+			std::mutex					mutex;
+			FreeBlock*					free_list;
+			ObjectPool::Statistics		stats;
+		};
+
+		struct PoolState
+		{
+			SizeClass			classes[size_class_count];
+			std::atomic<size_t>	oversized;
+
+			PoolState()
+				: oversized(0)
+			{
+				for (size_t i = 0; i < size_class_count; ++i)
+				{
+					classes[i].free_list = nullptr;
+					classes[i].stats = ObjectPool::Statistics{ (i + 1) * block_granularity, 0, 0, 0, 0, 0 };
+				}
+			}
+		};
+
+		PoolState& GetState()
+		{
+			// never destroyed, objects may still be released during static destruction
+			static PoolState* state = new PoolState;
+			return *state;
+		}
+
+		void Grow(SizeClass& sc)
+		{
+			size_t stride = sizeof(BlockHeader) + sc.stats.block_size;
+			size_t count = std::max(chunk_size / stride, size_t(16));
+
+			char* chunk = static_cast<char*>(::operator new(stride * count));
+			for (size_t i = 0; i < count; ++i)
+			{
+				auto block = reinterpret_cast<FreeBlock*>(chunk + stride * i + sizeof(BlockHeader));
+				block->next = sc.free_list;
+				sc.free_list = block;
+			}
+			sc.stats.capacity += count;
+		}
+	}
+
+	void* ObjectPool::Allocate(size_t size)
+	{
+		if (size == 0)
+			size = 1;
+
+		if (size > max_block_size)
+		{
+			++GetState().oversized;
+
+			auto header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size));
+			header->size_class = oversized_class;
+			return header + 1;
+		}
+
+		int index = static_cast<int>((size - 1) / block_granularity);
+		SizeClass& sc = GetState().classes[index];
+
+		std::lock_guard<std::mutex> lock(sc.mutex);
+
+		if (sc.free_list)
+		{
+			++sc.stats.hits;
+		}
+		else
+		{
+			++sc.stats.misses;
+			Grow(sc);
+		}
+
+		FreeBlock* block = sc.free_list;
+		sc.free_list = block->next;
+
+		if (++sc.stats.used > sc.stats.peak_used)
+			sc.stats.peak_used = sc.stats.used;
+
+		auto header = reinterpret_cast<BlockHeader*>(block) - 1;
+		header->size_class = index;
+		return block;
+	}
+
+	void ObjectPool::Deallocate(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		auto header = static_cast<BlockHeader*>(ptr) - 1;
+		if (header->size_class == oversized_class)
+		{
+			::operator delete(header);
+			return;
+		}
+
+		SizeClass& sc = GetState().classes[header->size_class];
+
+		std::lock_guard<std::mutex> lock(sc.mutex);
+
+		auto block = static_cast<FreeBlock*>(ptr);
+		block->next = sc.free_list;
+		sc.free_list = block;
+		--sc.stats.used;
+	}
+
+	int ObjectPool::GetSizeClassCount()
+	{
+		return static_cast<int>(size_class_count);
+	}
+
+	ObjectPool::Statistics ObjectPool::GetStatistics(int size_class)
+	{
+		E2D_ASSERT(size_class >= 0 && size_class < GetSizeClassCount() && "Size class out of range");
+
+		SizeClass& sc = GetState().classes[size_class];
+
+		std::lock_guard<std::mutex> lock(sc.mutex);
+		return sc.stats;
+	}
+
+	ObjectPool::Statistics ObjectPool::GetTotalStatistics()
+	{
+		Statistics total{ 0, 0, 0, 0, 0, 0 };
+		for (int i = 0; i < GetSizeClassCount(); ++i)
+		{
+			Statistics stats = GetStatistics(i);
+			total.hits += stats.hits;
+			total.misses += stats.misses;
+			total.used += stats.used;
+			total.peak_used += stats.peak_used;
+			total.capacity += stats.capacity;
+		}
+		return total;
+	}
+
+	size_t ObjectPool::GetOversizedCount()
+	{
+		return GetState().oversized;
+	}
+
+	void ObjectPool::DumpStatistics()
+	{
+		E2D_LOG(L"-------------------------- Object Pool --------------------------");
+		for (int i = 0; i < GetSizeClassCount(); ++i)
+		{
+			Statistics stats = GetStatistics(i);
+			if (!stats.capacity)
+				continue;
+
+			E2D_LOG(L"%4d bytes: hits=%d misses=%d used=%d peak=%d capacity=%d",
+				static_cast<int>(stats.block_size), static_cast<int>(stats.hits), static_cast<int>(stats.misses),
+				static_cast<int>(stats.used), static_cast<int>(stats.peak_used), static_cast<int>(stats.capacity));
+		}
+		E2D_LOG(L"------------------------- Oversized: %d -------------------------", static_cast<int>(GetOversizedCount()));
+	}
+}
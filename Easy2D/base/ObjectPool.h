@@ -0,0 +1,69 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../macros.h"
+
+namespace easy2d
+{
+	// ڴ
+	// СּĿ, Ϊ Object ڴ, ͷŵڴᱻͬСĶ
+	class E2D_API ObjectPool
+	{
+	public:
+		// ͳϢ
+		struct Statistics
+		{
+			size_t block_size;		// ڴС
+			size_t hits;			// ӿĴ
+			size_t misses;			// Ϊ, ҪڴĴ
+			size_t used;			// ʹõڴ
+			size_t peak_used;		// ʹõڴֵ
+			size_t capacity;		// ѷڴ
+		};
+
+		// ڴ, ڴСʱʹȫֶ
+		static void* Allocate(
+			size_t size
+		);
+
+		// ͷڴ
+		static void Deallocate(
+			void* ptr
+		);
+
+		// ȡСּ
+		static int GetSizeClassCount();
+
+		// ȡĳһСּͳϢ
+		static Statistics GetStatistics(
+			int size_class
+		);
+
+		// ȡдСּͳϢ֮, block_size Ϊ
+		static Statistics GetTotalStatistics();
+
+		// ȡڴС, ֱʹȫֶѷĴ
+		static size_t GetOversizedCount();
+
+		// ͳϢ
+		static void DumpStatistics();
+	};
+}
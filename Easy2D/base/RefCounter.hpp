@@ -29,23 +29,39 @@ namespace easy2d
 	{
 	public:
 		// ü
-		inline void Retain() { ++ref_count_; }
+		inline void Retain()
+		{
+			if (IsThreadSafe())
+				::InterlockedIncrement(&ref_count_);
+			else
+				++ref_count_;
+		}
 
 		// ü
 		inline void Release()
 		{
-			if (--ref_count_ <= 0)
+			const long count = IsThreadSafe() ? ::InterlockedDecrement(&ref_count_) : --ref_count_;
+			if (count <= 0)
 				delete this;
 		}
 
 		// ȡü
 		inline long GetRefCount() const { return ref_count_; }
 
+		// üǷʹԭӲ, ɳڲиڼ俪
+		static inline void SetThreadSafe(bool enabled) { ThreadSafeFlag() = enabled; }
+
+		// üǷʹԭӲ
+		static inline bool IsThreadSafe() { return ThreadSafeFlag(); }
+
 	protected:
 		RefCounter() : ref_count_(0) {}
 
 		virtual ~RefCounter() {}
 
+	private:
+		static inline bool& ThreadSafeFlag() { static bool flag = false; return flag; }
+
 	protected:
 		long ref_count_;
 	};
@@ -0,0 +1,221 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ThreadPool.h"
+#include "logs.h"
+
+namespace easy2d
+{
+	ThreadPool::ThreadPool()
+		: quit_(false)
+		, worker_count_(-1)
+		, job_id_(0)
+		, task_(nullptr)
+		, remaining_(0)
+	{
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		Shutdown();
+	}
+
+	void ThreadPool::SetWorkerCount(int count)
+	{
+		if (worker_count_ == count)
+			return;
+
+		Shutdown();
+		worker_count_ = count;
+	}
+
+	int ThreadPool::GetWorkerCount() const
+	{
+		if (worker_count_ < 0)
+			return std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+		return worker_count_;
+	}
+
+	void ThreadPool::Start()
+	{
+		int count = GetWorkerCount();
+
+		E2D_LOG(L"Starting %d worker threads", count);
+
+		quit_ = false;
+		worker_count_ = count;
+
+		// the calling thread owns queue 0
+		queues_.clear();
+		for (int i = 0; i <= count; ++i)
+			queues_.emplace_back(new WorkQueue);
+
+		for (int i = 1; i <= count; ++i)
+			workers_.emplace_back(&ThreadPool::WorkerThread, this, i);
+	}
+
+	void ThreadPool::Shutdown()
+	{
+		if (!workers_.empty())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				quit_ = true;
+			}
+			cv_start_.notify_all();
+
+			for (auto& worker : workers_)
+				worker.join();
+
+			workers_.clear();
+		}
+		queues_.clear();
+	}
+
+	void ThreadPool::ParallelFor(int count, Task const& task)
+	{
+		if (count <= 0)
+			return;
+
+		if (queues_.empty())
+			Start();
+
+		if (workers_.empty() || count == 1)
+		{
+			for (int i = 0; i < count; ++i)
+				task(i);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			task_ = &task;
+			error_ = nullptr;
+			remaining_ = count;
+		}
+
+		// deal contiguous blocks, so neighbouring items stay on the same thread
+		const int queue_count = static_cast<int>(queues_.size());
+		for (int i = 0; i < queue_count; ++i)
+		{
+			int begin = count * i / queue_count;
+			int end = count * (i + 1) / queue_count;
+
+			std::lock_guard<std::mutex> lock(queues_[i]->mutex);
+			for (int item = begin; item < end; ++item)
+				queues_[i]->items.push_back(item);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			++job_id_;
+		}
+		cv_start_.notify_all();
+
+		Work(0);
+
+		std::exception_ptr error;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_done_.wait(lock, [this]() { return remaining_ == 0; });
+
+			task_ = nullptr;
+			error = error_;
+			error_ = nullptr;
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void ThreadPool::WorkerThread(int index)
+	{
+		unsigned int job_id = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				cv_start_.wait(lock, [&]() { return quit_ || job_id != job_id_; });
+
+				if (quit_)
+					return;
+
+				job_id = job_id_;
+			}
+
+			Work(index);
+		}
+	}
+
+	void ThreadPool::Work(int index)
+	{
+		int item = 0;
+		while (Pop(index, item) || Steal(index, item))
+		{
+			try
+			{
+				(*task_)(item);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (!error_)
+					error_ = std::current_exception();
+			}
+
+			if (--remaining_ == 0)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				cv_done_.notify_all();
+			}
+		}
+	}
+
+	bool ThreadPool::Pop(int index, int& item)
+	{
+		WorkQueue& queue = *queues_[index];
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.items.empty())
+			return false;
+
+		item = queue.items.back();
+		queue.items.pop_back();
+		return true;
+	}
+
+	bool ThreadPool::Steal(int index, int& item)
+	{
+		const int queue_count = static_cast<int>(queues_.size());
+		for (int i = 1; i < queue_count; ++i)
+		{
+			WorkQueue& queue = *queues_[(index + i) % queue_count];
+
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (!queue.items.empty())
+			{
+				item = queue.items.front();
+				queue.items.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../macros.h"
+#include "../common/Singleton.hpp"
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+namespace easy2d
+{
+	// ȡ̳߳
+	// ÿ߳ӵԼ, ԼĶΪʱ̵߳Ķͷȡ
+	class E2D_API ThreadPool
+		: public Singleton<ThreadPool>
+	{
+		E2D_DECLARE_SINGLETON(ThreadPool);
+
+	public:
+		using Task = std::function<void(int)>;
+
+		// ִ task(0) ... task(count - 1), ߳Ҳִ, ȫɺ󷵻
+		// ׳ĵһ쳣ڵ߳׳
+		void ParallelFor(
+			int count,
+			Task const& task
+		);
+
+		// ù߳, ĬΪһ
+		void SetWorkerCount(
+			int count
+		);
+
+		// ȡ߳
+		int GetWorkerCount() const;
+
+		// ֹͣй߳
+		void Shutdown();
+
+	private:
+		ThreadPool();
+
+		~ThreadPool();
+
+		void Start();
+
+		void WorkerThread(int index);
+
+		void Work(int index);
+
+		bool Pop(int index, int& item);
+
+		bool Steal(int index, int& item);
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex		mutex;
+			std::deque<int>	items;
+		};
+
+		bool					quit_;
+		int						worker_count_;
+		unsigned int			job_id_;
+		Task const*				task_;
+		std::atomic<int>		remaining_;
+		std::exception_ptr		error_;
+		std::mutex				mutex_;
+		std::condition_variable	cv_start_;
+		std::condition_variable	cv_done_;
+
+		std::vector<std::thread>					workers_;
+		std::vector<std::unique_ptr<WorkQueue>>	queues_;
+	};
+}
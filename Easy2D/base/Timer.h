@@ -20,7 +20,7 @@
 
 #pragma once
 #include "../common/helper.h"
-#include "../common/IntrusiveList.hpp"
+#include "../common/IntrusiveRawList.hpp"
 #include "Object.h"
 #include "time.h"
 #include <functional>
@@ -34,10 +34,10 @@ namespace easy2d
     // ʱ
 	class E2D_API Timer
 		: public virtual Object
-		, protected IntrusiveListItem<TimerPtr>
+		, protected IntrusiveRawListItem<Timer>
 	{
 		friend class TimerManager;
-		friend class IntrusiveList<TimerPtr>;
+		friend class IntrusiveRawList<Timer>;
 
 		using Callback = std::function<void()>;
 
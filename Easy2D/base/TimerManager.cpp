@@ -20,18 +20,20 @@
 
 #include "TimerManager.h"
 #include "../base/logs.h"
+#include "../base/Trace.h"
 
 namespace easy2d
 {
 	void TimerManager::UpdateTimers(Duration dt)
 	{
+		E2D_PROFILE_SCOPE("TimerManager::UpdateTimers");
+
 		if (timers_.IsEmpty())
 			return;
 
-		TimerPtr next;
-		for (auto timer = timers_.First(); timer; timer = next)
+		for (Timers::Iterator iter(timers_); iter; iter.Next())
 		{
-			next = timer->NextItem();
+			Timer* timer = iter.Get();
 
 			bool remove_after_update = false;
 			timer->Update(dt, remove_after_update);
@@ -48,7 +50,7 @@ namespace easy2d
 		if (timer)
 		{
 			timer->Reset();
-			timers_.PushBack(timer);
+			timers_.PushBack(timer.Get());
 		}
 	}
 
@@ -57,7 +59,7 @@ namespace easy2d
 		if (timers_.IsEmpty())
 			return;
 
-		for (auto timer = timers_.First().Get(); timer; timer = timer->NextItem().Get())
+		for (auto timer = timers_.First(); timer; timer = timer->NextItem())
 		{
 			if (timer->IsName(name))
 			{
@@ -71,7 +73,7 @@ namespace easy2d
 		if (timers_.IsEmpty())
 			return;
 		
-		for (auto timer = timers_.First().Get(); timer; timer = timer->NextItem().Get())
+		for (auto timer = timers_.First(); timer; timer = timer->NextItem())
 		{
 			if (timer->IsName(name))
 			{
@@ -85,7 +87,7 @@ namespace easy2d
 		if (timers_.IsEmpty())
 			return;
 
-		TimerPtr next;
+		Timer* next;
 		for (auto timer = timers_.First(); timer; timer = next)
 		{
 			next = timer->NextItem();
@@ -101,7 +103,7 @@ namespace easy2d
 		if (timers_.IsEmpty())
 			return;
 
-		for (auto timer = timers_.First().Get(); timer; timer = timer->NextItem().Get())
+		for (auto timer = timers_.First(); timer; timer = timer->NextItem())
 		{
 			timer->Stop();
 		}
@@ -112,7 +114,7 @@ namespace easy2d
 		if (timers_.IsEmpty())
 			return;
 
-		for (auto timer = timers_.First().Get(); timer; timer = timer->NextItem().Get())
+		for (auto timer = timers_.First(); timer; timer = timer->NextItem())
 		{
 			timer->Start();
 		}
@@ -25,7 +25,7 @@ namespace easy2d
 {
 	class E2D_API TimerManager
 	{
-		using Timers = IntrusiveList<TimerPtr>;
+		using Timers = IntrusiveRawList<Timer>;
 
 	public:
 		// 
@@ -0,0 +1,201 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Trace.h"
+#include "logs.h"
+#include <fstream>
+#include <iomanip>
+#include <memory>
+
+namespace easy2d
+{
+	namespace
+	{
+		const int default_buffer_size = 1 << 16;
+
+		// each thread finds its buffer without taking the lock
+		__declspec(thread) void* current_thread_buffer = nullptr;
+	}
+
+	struct Tracer::ThreadBuffer
+	{
+		unsigned int					mask;
+		std::atomic<unsigned int>		written;
+		std::unique_ptr<TraceEvent[]>	events;
+	};
+
+	Tracer::Tracer()
+		: enabled_(true)
+		, buffer_size_(default_buffer_size)
+		, base_(Now())
+		, frequency_(0)
+		, fls_index_(FLS_OUT_OF_INDEXES)
+	{
+		LARGE_INTEGER freq;
+		::QueryPerformanceFrequency(&freq);
+		frequency_ = static_cast<double>(freq.QuadPart) / 1000000.0;
+
+		// the fiber local storage callback tells us when a thread exits
+		fls_index_ = ::FlsAlloc(&Tracer::OnThreadExit);
+	}
+
+	Tracer::~Tracer()
+	{
+		// FlsFree runs the callback for every thread still holding a buffer
+		if (fls_index_ != FLS_OUT_OF_INDEXES)
+			::FlsFree(fls_index_);
+
+		for (auto buffer : buffers_)
+			delete buffer;
+	}
+
+	void Tracer::SetEnabled(bool enabled)
+	{
+		enabled_.store(enabled, std::memory_order_relaxed);
+	}
+
+	void Tracer::SetBufferSize(int events)
+	{
+		E2D_ASSERT(events > 0 && "Buffer size must be positive");
+
+		int size = 1;
+		while (size < events && size < (1 << 30))
+			size <<= 1;
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		buffer_size_ = size;
+	}
+
+	void Tracer::Clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto buffer : buffers_)
+			buffer->written.store(0, std::memory_order_relaxed);
+	}
+
+	void Tracer::Record(char const* name, long long start, long long end)
+	{
+		ThreadBuffer* buffer = static_cast<ThreadBuffer*>(current_thread_buffer);
+		if (!buffer)
+		{
+			buffer = CreateThreadBuffer();
+			current_thread_buffer = buffer;
+		}
+
+		const unsigned int index = buffer->written.load(std::memory_order_relaxed);
+
+		TraceEvent& evt = buffer->events[index & buffer->mask];
+		evt.name = name;
+		evt.start = start;
+		evt.end = end;
+		evt.thread_id = ::GetCurrentThreadId();
+
+		buffer->written.store(index + 1, std::memory_order_release);
+	}
+
+	Tracer::ThreadBuffer* Tracer::CreateThreadBuffer()
+	{
+		ThreadBuffer* buffer = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			if (!free_buffers_.empty())
+			{
+				// reuse the ring of an exited thread, its events stay until they are overwritten
+				buffer = free_buffers_.back();
+				free_buffers_.pop_back();
+			}
+			else
+			{
+				buffer = new ThreadBuffer;
+				buffer->mask = static_cast<unsigned int>(buffer_size_ - 1);
+				buffer->written.store(0, std::memory_order_relaxed);
+				buffer->events.reset(new TraceEvent[buffer_size_]);
+
+				buffers_.push_back(buffer);
+			}
+		}
+
+		if (fls_index_ != FLS_OUT_OF_INDEXES)
+			::FlsSetValue(fls_index_, buffer);
+		return buffer;
+	}
+
+	void Tracer::ReleaseThreadBuffer(ThreadBuffer* buffer)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		free_buffers_.push_back(buffer);
+	}
+
+	void WINAPI Tracer::OnThreadExit(void* buffer)
+	{
+		if (buffer)
+		{
+			current_thread_buffer = nullptr;
+			Tracer::Instance().ReleaseThreadBuffer(static_cast<ThreadBuffer*>(buffer));
+		}
+	}
+
+	String Tracer::ToJSON() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		StringStream ss;
+		ss << std::fixed << std::setprecision(3);
+		ss << L"{\"traceEvents\":[";
+
+		bool first = true;
+		for (auto buffer : buffers_)
+		{
+			const unsigned int written = buffer->written.load(std::memory_order_acquire);
+			const unsigned int size = buffer->mask + 1;
+			const unsigned int count = written < size ? written : size;
+
+			for (unsigned int i = written - count; i != written; ++i)
+			{
+				TraceEvent const& evt = buffer->events[i & buffer->mask];
+
+				ss << (first ? L"\n" : L",\n");
+				ss << L"{\"name\":\"" << evt.name
+					<< L"\",\"ph\":\"X\",\"pid\":1,\"tid\":" << evt.thread_id
+					<< L",\"ts\":" << (evt.start - base_) / frequency_
+					<< L",\"dur\":" << (evt.end - evt.start) / frequency_
+					<< L"}";
+				first = false;
+			}
+		}
+
+		ss << L"\n],\"displayTimeUnit\":\"ms\"}\n";
+		return ss.str();
+	}
+
+	bool Tracer::SaveToFile(String const& file_path) const
+	{
+		std::wofstream file(file_path.c_str());
+		if (!file)
+		{
+			E2D_WARNING_LOG(L"Failed to open trace file: %s", file_path.c_str());
+			return false;
+		}
+
+		file << ToJSON();
+		return static_cast<bool>(file);
+	}
+}
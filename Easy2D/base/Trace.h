@@ -0,0 +1,156 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../common/helper.h"
+#include "../common/Singleton.hpp"
+#include <atomic>
+#include <mutex>
+
+// ׷
+//  config.h ж E2D_ENABLE_PROFILING Ч, 겻κδ
+// :
+//     void Foo() { E2D_PROFILE_SCOPE("Foo"); ... }
+// Ʊַ
+#if defined(E2D_ENABLE_PROFILING)
+#	define E2D_PROFILE_CONCAT_IMPL(A, B)	A##B
+#	define E2D_PROFILE_CONCAT(A, B)		E2D_PROFILE_CONCAT_IMPL(A, B)
+#	define E2D_PROFILE_SCOPE(NAME)		::easy2d::TraceScope E2D_PROFILE_CONCAT(e2d_profile_scope_, __LINE__)(NAME)
+#else
+#	define E2D_PROFILE_SCOPE(NAME)		__noop
+#endif
+
+namespace easy2d
+{
+	// ׷¼
+	struct TraceEvent
+	{
+		char const*	name;
+		long long	start;		// ֵܼ
+		long long	end;
+		DWORD		thread_id;
+	};
+
+
+	// ׷ټ¼
+	// ÿ߳жĻλ, д󸲸¼
+	// Ĭÿ 65536 ¼, 64 λԼռ 2 MB ڴ
+	// ߳˳󻺳֮󴴽̸߳, е¼Ϊֹ
+	// ԵΪ Chrome ׷ٸʽ (chrome://tracing)
+	class E2D_API Tracer
+		: public Singleton<Tracer>
+	{
+		E2D_DECLARE_SINGLETON(Tracer);
+
+	public:
+		// ͣ¼, ĬϿ
+		void SetEnabled(
+			bool enabled
+		);
+
+		// ÿ̻߳¼, ȡΪ 2 
+		// ֻӰ֮󴴽Ļ, Ҫڼ¼ǰ
+		void SetBufferSize(
+			int events
+		);
+
+		// ̵߳¼
+		void Clear();
+
+		// Ϊ Chrome ׷ٸʽ JSON
+		// ߳ڼ¼ʱ, д¼ܲ
+		String ToJSON() const;
+
+		//  JSON ļ
+		bool SaveToFile(
+			String const& file_path
+		) const;
+
+		// ¼¼
+		void Record(
+			char const* name,
+			long long start,
+			long long end
+		);
+
+		inline bool IsEnabled() const			{ return enabled_.load(std::memory_order_relaxed); }
+
+		static inline long long Now()
+		{
+			LARGE_INTEGER count;
+			::QueryPerformanceCounter(&count);
+			return count.QuadPart;
+		}
+
+	private:
+		Tracer();
+
+		~Tracer();
+
+		struct ThreadBuffer;
+
+		ThreadBuffer* CreateThreadBuffer();
+
+		void ReleaseThreadBuffer(
+			ThreadBuffer* buffer
+		);
+
+		static void WINAPI OnThreadExit(
+			void* buffer
+		);
+
+	private:
+		std::atomic<bool>		enabled_;
+		int						buffer_size_;
+		long long				base_;
+		double					frequency_;
+		mutable std::mutex		mutex_;
+		DWORD					fls_index_;
+		Array<ThreadBuffer*>	buffers_;
+		Array<ThreadBuffer*>	free_buffers_;
+	};
+
+
+	// ׷, 뿪ʱ¼¼
+	class TraceScope
+	{
+	public:
+		explicit TraceScope(char const* name)
+			: name_(name)
+			, start_(Tracer::Instance().IsEnabled() ? Tracer::Now() : 0)
+		{
+		}
+
+		~TraceScope()
+		{
+			if (start_)
+				Tracer::Instance().Record(name_, start_, Tracer::Now());
+		}
+
+	private:
+		TraceScope(TraceScope const&) = delete;
+
+		TraceScope& operator=(TraceScope const&) = delete;
+
+	private:
+		char const*	name_;
+		long long	start_;
+	};
+}
@@ -18,110 +18,18 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+
 #include "time.h"
 #include "logs.h"
-#include <regex>
-#include <unordered_map>
 
 namespace easy2d
 {
 	namespace time
 	{
-		//-------------------------------------------------------
-		// TimePoint
-		//-------------------------------------------------------
-
-		TimePoint::TimePoint()
-		{
-		}
-
-		TimePoint::TimePoint(long dur)
-			: dur_(dur)
-		{
-		}
-
-		const TimePoint TimePoint::operator+(const Duration & dur) const
-		{
-			return TimePoint{ dur_ + dur.Milliseconds() };
-		}
-
-		const TimePoint TimePoint::operator-(const Duration & dur) const
-		{
-			return TimePoint{ dur_ - dur.Milliseconds() };
-		}
-
-		TimePoint & TimePoint::operator+=(const Duration & other)
-		{
-			dur_ += other.Milliseconds();
-			return (*this);
-		}
-
-		TimePoint & TimePoint::operator-=(const Duration &other)
-		{
-			dur_ -= other.Milliseconds();
-			return (*this);
-		}
-
-		const Duration TimePoint::operator-(const TimePoint & other) const
-		{
-			return Duration(dur_ - other.dur_);
-		}
-
-
 		//-------------------------------------------------------
 		// Duration
 		//-------------------------------------------------------
 
-		const Duration Millisecond	= 1L;
-		const Duration Second		= 1000 * Millisecond;
-		const Duration Minute		= 60 * Second;
-		const Duration Hour			= 60 * Minute;
-
-		namespace
-		{
-			const auto duration_regex = std::wregex(LR"([-+]?([0-9]*(\.[0-9]*)?[a-z]+)+)");
-
-			typedef std::unordered_map<std::wstring, Duration> UnitMap;
-			const auto unit_map = UnitMap
-			{
-				{L"ms", Millisecond},
-				{L"s", Second},
-				{L"m", Minute},
-				{L"h", Hour}
-			};
-		}
-
-		Duration::Duration()
-			: milliseconds_(0)
-		{
-		}
-
-		Duration::Duration(long milliseconds)
-			: milliseconds_(milliseconds)
-		{
-		}
-
-		float Duration::Seconds() const
-		{
-			long long sec = milliseconds_ / Second.milliseconds_;
-			long long ms = milliseconds_ % Second.milliseconds_;
-			return static_cast<float>(sec) + static_cast<float>(ms) / 1000.f;
-		}
-
-		float Duration::Minutes() const
-		{
-			long long min = milliseconds_ / Minute.milliseconds_;
-			long long ms = milliseconds_ % Minute.milliseconds_;
-			return static_cast<float>(min) + static_cast<float>(ms) / (60 * 1000.f);
-		}
-
-		float Duration::Hours() const
-		{
-			long long hour = milliseconds_ / Hour.milliseconds_;
-			long long ms = milliseconds_ % Hour.milliseconds_;
-			return static_cast<float>(hour) + static_cast<float>(ms) / (60 * 60 * 1000.f);
-		}
-
 		std::wstring easy2d::time::Duration::ToString() const
 		{
 			if (IsZero())
@@ -130,14 +38,15 @@ namespace easy2d
 			}
 
 			std::wstring result;
-			long long hour = milliseconds_ / Hour.milliseconds_;
-			long long min = milliseconds_ / Minute.milliseconds_ - hour * 60;
-			long long sec = milliseconds_ / Second.milliseconds_ - (hour * 60 * 60 + min * 60);
-			long long ms = milliseconds_ % Second.milliseconds_;
-
-			if (milliseconds_ < 0)
+			if (microseconds_ < 0)
 				result.append(L"-");
 
+			const long long total = microseconds_ < 0 ? -microseconds_ : microseconds_;
+			const long long hour = total / Hour.microseconds_;
+			const long long min = total / Minute.microseconds_ - hour * 60;
+			const long long sec = total / Second.microseconds_ - (hour * 60 * 60 + min * 60);
+			const long long us = total % Second.microseconds_;
+
 			if (hour)
 			{
 				result.append(std::to_wstring(hour)).append(L"h");
@@ -148,17 +57,15 @@ namespace easy2d
 				result.append(std::to_wstring(min)).append(L"m");
 			}
 
-			if (ms != 0)
+			if (total < Millisecond.microseconds_)
 			{
-				auto float_to_str = [](float val) -> std::wstring
-				{
-					wchar_t buf[10] = {};
-					::swprintf_s(buf, L"%.2f", val);
-					return std::wstring(buf);
-				};
-
-				result.append(float_to_str(static_cast<float>(sec) + static_cast<float>(ms) / 1000.f))
-					.append(L"s");
+				result.append(std::to_wstring(us)).append(L"us");
+			}
+			else if (us != 0)
+			{
+				wchar_t buf[32] = {};
+				::swprintf_s(buf, L"%.3f", static_cast<double>(sec) + static_cast<double>(us) / 1e6);
+				result.append(buf).append(L"s");
 			}
 			else if (sec != 0)
 			{
@@ -167,179 +74,6 @@ namespace easy2d
 			return result;
 		}
 
-		bool Duration::operator==(const Duration & other) const
-		{
-			return milliseconds_ == other.milliseconds_;
-		}
-
-		bool Duration::operator!=(const Duration & other) const
-		{
-			return milliseconds_ != other.milliseconds_;
-		}
-
-		bool Duration::operator>(const Duration & other) const
-		{
-			return milliseconds_ > other.milliseconds_;
-		}
-
-		bool Duration::operator>=(const Duration & other) const
-		{
-			return milliseconds_ >= other.milliseconds_;
-		}
-
-		bool Duration::operator<(const Duration & other) const
-		{
-			return milliseconds_ < other.milliseconds_;
-		}
-
-		bool Duration::operator<=(const Duration & other) const
-		{
-			return milliseconds_ <= other.milliseconds_;
-		}
-
-		float easy2d::time::Duration::operator/(const Duration & other) const
-		{
-			return static_cast<float>(milliseconds_) / other.milliseconds_;
-		}
-
-		const Duration Duration::operator+(const Duration & other) const
-		{
-			return Duration(milliseconds_ + other.milliseconds_);
-		}
-
-		const Duration Duration::operator-(const Duration & other) const
-		{
-			return Duration(milliseconds_ - other.milliseconds_);
-		}
-
-		const Duration Duration::operator-() const
-		{
-			return Duration(-milliseconds_);
-		}
-
-		const Duration Duration::operator*(int val) const
-		{
-			return Duration(milliseconds_ * val);
-		}
-
-		const Duration easy2d::time::Duration::operator*(unsigned long long val) const
-		{
-			return Duration(static_cast<long>(milliseconds_ * val));
-		}
-
-		const Duration Duration::operator*(float val) const
-		{
-			return Duration(static_cast<long>(milliseconds_ * val));
-		}
-
-		const Duration Duration::operator*(double val) const
-		{
-			return Duration(static_cast<long>(milliseconds_ * val));
-		}
-
-		const Duration Duration::operator*(long double val) const
-		{
-			return Duration(static_cast<long>(milliseconds_ * val));
-		}
-
-		const Duration Duration::operator/(int val) const
-		{
-			return Duration(milliseconds_ / val);
-		}
-
-		const Duration Duration::operator/(float val) const
-		{
-			return Duration(static_cast<long>(milliseconds_ / val));
-		}
-
-		const Duration Duration::operator/(double val) const
-		{
-			return Duration(static_cast<long>(milliseconds_ / val));
-		}
-
-		Duration & Duration::operator+=(const Duration &other)
-		{
-			milliseconds_ += other.milliseconds_;
-			return (*this);
-		}
-
-		Duration & Duration::operator-=(const Duration &other)
-		{
-			milliseconds_ -= other.milliseconds_;
-			return (*this);
-		}
-
-		Duration & Duration::operator*=(int val)
-		{
-			milliseconds_ *= val;
-			return (*this);
-		}
-
-		Duration & Duration::operator/=(int val)
-		{
-			milliseconds_ = static_cast<long>(milliseconds_ / val);
-			return (*this);
-		}
-
-		Duration & Duration::operator*=(float val)
-		{
-			milliseconds_ = static_cast<long>(milliseconds_ * val);
-			return (*this);
-		}
-
-		Duration & Duration::operator/=(float val)
-		{
-			milliseconds_ = static_cast<long>(milliseconds_ / val);
-			return (*this);
-		}
-
-		Duration & Duration::operator*=(double val)
-		{
-			milliseconds_ = static_cast<long>(milliseconds_ * val);
-			return (*this);
-		}
-
-		Duration & Duration::operator/=(double val)
-		{
-			milliseconds_ = static_cast<long>(milliseconds_ / val);
-			return (*this);
-		}
-
-		const Duration easy2d::time::operator*(int val, const Duration & dur)
-		{
-			return dur * val;
-		}
-
-		const Duration easy2d::time::operator/(int val, const Duration & dur)
-		{
-			return dur / val;
-		}
-
-		const Duration easy2d::time::operator*(float val, const Duration & dur)
-		{
-			return dur * val;
-		}
-
-		const Duration easy2d::time::operator/(float val, const Duration & dur)
-		{
-			return dur / val;
-		}
-
-		const Duration easy2d::time::operator*(double val, const Duration & dur)
-		{
-			return dur * val;
-		}
-
-		const Duration easy2d::time::operator/(double val, const Duration & dur)
-		{
-			return dur / val;
-		}
-
-		const Duration easy2d::time::operator*(long double val, const Duration & dur)
-		{
-			return dur * val;
-		}
-
 		std::wostream & easy2d::time::operator<<(std::wostream & out, const Duration & dur)
 		{
 			return out << dur.ToString();
@@ -370,25 +104,59 @@ namespace easy2d
 			LARGE_INTEGER count;
 			QueryPerformanceCounter(&count);
 
-			const long long whole = (count.QuadPart / freq.QuadPart) * 1000LL;
-			const long long part = (count.QuadPart % freq.QuadPart) * 1000LL / freq.QuadPart;
-			return TimePoint{ static_cast<long>(whole + part) };
+			const long long whole = (count.QuadPart / freq.QuadPart) * 1000000LL;
+			const long long part = (count.QuadPart % freq.QuadPart) * 1000000LL / freq.QuadPart;
+			return TimePoint{ whole + part };
 		}
 
-		Duration easy2d::time::ParseDuration(const std::wstring & str)
+		namespace
 		{
-			size_t len = str.length();
-			size_t pos = 0;
-			bool negative = false;
-			Duration d;
+			inline bool IsDigit(wchar_t ch)
+			{
+				return L'0' <= ch && ch <= L'9';
+			}
 
-			if (!std::regex_match(str, duration_regex))
+			inline bool IsUnitChar(wchar_t ch)
 			{
-				E2D_ERROR_LOG(L"time::ParseDuration failed, invalid duration");
-				return Duration();
+				return L'a' <= ch && ch <= L'z';
 			}
 
-			if (str.empty() || str == L"0") { return d; }
+			// returns the unit length in microseconds, or 0 if the unit is unknown
+			long long UnitToMicroseconds(const wchar_t* unit, size_t len)
+			{
+				if (len == 1)
+				{
+					switch (unit[0])
+					{
+					case L's': return Second.Microseconds();
+					case L'm': return Minute.Microseconds();
+					case L'h': return Hour.Microseconds();
+					}
+				}
+				else if (len == 2 && unit[1] == L's')
+				{
+					switch (unit[0])
+					{
+					case L'm': return Millisecond.Microseconds();
+					case L'u': return Microsecond.Microseconds();
+					}
+				}
+				return 0;
+			}
+		}
+
+		bool ParseDuration(const wchar_t* str, size_t len, Duration& output)
+		{
+			output = Duration();
+
+			size_t pos = 0;
+			bool negative = false;
+
+			if (len == 0)
+				return false;
+
+			if (len == 1 && str[0] == L'0')
+				return true;
 
 			// λ
 			if (str[0] == L'-' || str[0] == L'+')
@@ -397,57 +165,58 @@ namespace easy2d
 				pos++;
 			}
 
+			if (pos == len)
+				return false;
+
+			long long total = 0;
 			while (pos < len)
 			{
 				// ֵ
-				size_t i = pos;
-				for (; i < len; ++i)
-				{
-					wchar_t ch = str[i];
-					if (!(ch == L'.' || L'0' <= ch && ch <= L'9'))
-					{
-						break;
-					}
-				}
+				long long whole = 0;
+				double frac = 0.0;
+				double scale = 1.0;
+				size_t digits = 0;
 
-				std::wstring num_str = str.substr(pos, i - pos);
-				pos = i;
-
-				if (num_str.empty() || num_str == L".")
+				for (; pos < len && IsDigit(str[pos]); ++pos, ++digits)
 				{
-					E2D_ERROR_LOG(L"time::ParseDuration failed, invalid duration");
-					return Duration();
+					whole = whole * 10 + (str[pos] - L'0');
 				}
 
-				// λ
-				for (; i < len; ++i)
+				if (pos < len && str[pos] == L'.')
 				{
-					wchar_t ch = str[i];
-					if (ch == L'.' || L'0' <= ch && ch <= L'9')
+					for (++pos; pos < len && IsDigit(str[pos]); ++pos, ++digits)
 					{
-						break;
+						scale *= 0.1;
+						frac += (str[pos] - L'0') * scale;
 					}
 				}
 
-				std::wstring unit_str = str.substr(pos, i - pos);
-				pos = i;
+				if (digits == 0)
+					return false;
 
-				if (unit_map.find(unit_str) == unit_map.end())
-				{
-					E2D_ERROR_LOG(L"time::ParseDuration failed, invalid duration");
-					return Duration();
-				}
+				// λ
+				const size_t unit_start = pos;
+				for (; pos < len && IsUnitChar(str[pos]); ++pos);
+
+				const long long unit = UnitToMicroseconds(str + unit_start, pos - unit_start);
+				if (unit == 0)
+					return false;
 
-				double num = std::stod(num_str);
-				Duration unit = unit_map.at(unit_str);
-				d += unit * num;
+				total += whole * unit + static_cast<long long>(frac * unit + 0.5);
 			}
 
-			if (negative)
+			output = Duration::FromMicroseconds(negative ? -total : total);
+			return true;
+		}
+
+		Duration easy2d::time::ParseDuration(const std::wstring & str)
+		{
+			Duration d;
+			if (!ParseDuration(str.c_str(), str.length(), d))
 			{
-				d = -d;
+				E2D_ERROR_LOG(L"time::ParseDuration failed, invalid duration");
 			}
 			return d;
 		}
 	}
-}
\ No newline at end of file
+}
@@ -18,6 +18,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+
 #pragma once
 #include "../macros.h"
 
@@ -27,6 +28,7 @@ namespace easy2d
 	{
 		// ʱ
 		//
+		// ڲ 64 λ΢
 		// ʱαʾ:
 		//     5 : time::Second * 5
 		//     1.5 Сʱ: time::Hour * 1.5
@@ -38,82 +40,107 @@ namespace easy2d
 		//
 		struct E2D_API Duration
 		{
-			Duration();
+			E2D_CONSTEXPR_FUNC Duration()
+				: microseconds_(0)
+			{
+			}
 
-			Duration(
+			E2D_CONSTEXPR_FUNC Duration(
 				long milliseconds
-			);
+			)
+				: microseconds_(static_cast<long long>(milliseconds) * 1000LL)
+			{
+			}
+
+			// ΢ʱ
+			static E2D_CONSTEXPR_FUNC Duration FromMicroseconds(long long microseconds)
+			{
+				return Duration(microseconds, 0);
+			}
+
+			// תΪ΢
+			E2D_CONSTEXPR_FUNC long long Microseconds() const { return microseconds_; }
 
 			// תΪ
-			inline long Milliseconds() const { return milliseconds_; }
+			E2D_CONSTEXPR_FUNC long Milliseconds() const { return static_cast<long>(microseconds_ / 1000LL); }
 
 			// תΪ
-			float Seconds() const;
+			E2D_CONSTEXPR_FUNC float Seconds() const { return static_cast<float>(static_cast<double>(microseconds_) / 1e6); }
 
 			// תΪ
-			float Minutes() const;
+			E2D_CONSTEXPR_FUNC float Minutes() const { return static_cast<float>(static_cast<double>(microseconds_) / 6e7); }
 
 			// תΪСʱ
-			float Hours() const;
+			E2D_CONSTEXPR_FUNC float Hours() const { return static_cast<float>(static_cast<double>(microseconds_) / 3.6e9); }
 
 			// ʱǷ
-			inline bool IsZero() const { return milliseconds_ == 0LL; }
+			E2D_CONSTEXPR_FUNC bool IsZero() const { return microseconds_ == 0LL; }
 
 			// תΪַ
 			std::wstring ToString() const;
 
-			inline operator bool() const { return !IsZero(); }
-
-			bool operator== (const Duration &) const;
-			bool operator!= (const Duration &) const;
-			bool operator> (const Duration &) const;
-			bool operator>= (const Duration &) const;
-			bool operator< (const Duration &) const;
-			bool operator<= (const Duration &) const;
-
-			float operator / (const Duration &) const;
-
-			const Duration operator + (const Duration &) const;
-			const Duration operator - (const Duration &) const;
-			const Duration operator - () const;
-			const Duration operator * (int) const;
-			const Duration operator * (unsigned long long) const;
-			const Duration operator * (float) const;
-			const Duration operator * (double) const;
-			const Duration operator * (long double) const;
-			const Duration operator / (int) const;
-			const Duration operator / (float) const;
-			const Duration operator / (double) const;
-
-			Duration& operator += (const Duration &);
-			Duration& operator -= (const Duration &);
-			Duration& operator *= (int);
-			Duration& operator *= (float);
-			Duration& operator *= (double);
-			Duration& operator /= (int);
-			Duration& operator /= (float);
-			Duration& operator /= (double);
-
-			friend const Duration operator* (int, const Duration &);
-			friend const Duration operator* (float, const Duration &);
-			friend const Duration operator* (double, const Duration &);
-			friend const Duration operator* (long double, const Duration &);
-			friend const Duration operator/ (int, const Duration &);
-			friend const Duration operator/ (float, const Duration &);
-			friend const Duration operator/ (double, const Duration &);
+			E2D_CONSTEXPR_FUNC operator bool() const { return !IsZero(); }
+
+			E2D_CONSTEXPR_FUNC bool operator== (const Duration & other) const { return microseconds_ == other.microseconds_; }
+			E2D_CONSTEXPR_FUNC bool operator!= (const Duration & other) const { return microseconds_ != other.microseconds_; }
+			E2D_CONSTEXPR_FUNC bool operator> (const Duration & other) const { return microseconds_ > other.microseconds_; }
+			E2D_CONSTEXPR_FUNC bool operator>= (const Duration & other) const { return microseconds_ >= other.microseconds_; }
+			E2D_CONSTEXPR_FUNC bool operator< (const Duration & other) const { return microseconds_ < other.microseconds_; }
+			E2D_CONSTEXPR_FUNC bool operator<= (const Duration & other) const { return microseconds_ <= other.microseconds_; }
+
+			E2D_CONSTEXPR_FUNC float operator / (const Duration & other) const
+			{
+				return static_cast<float>(static_cast<double>(microseconds_) / static_cast<double>(other.microseconds_));
+			}
+
+			E2D_CONSTEXPR_FUNC const Duration operator + (const Duration & other) const { return FromMicroseconds(microseconds_ + other.microseconds_); }
+			E2D_CONSTEXPR_FUNC const Duration operator - (const Duration & other) const { return FromMicroseconds(microseconds_ - other.microseconds_); }
+			E2D_CONSTEXPR_FUNC const Duration operator - () const { return FromMicroseconds(-microseconds_); }
+			E2D_CONSTEXPR_FUNC const Duration operator * (int val) const { return FromMicroseconds(microseconds_ * val); }
+			E2D_CONSTEXPR_FUNC const Duration operator * (unsigned long long val) const { return FromMicroseconds(microseconds_ * static_cast<long long>(val)); }
+			E2D_CONSTEXPR_FUNC const Duration operator * (float val) const { return FromMicroseconds(static_cast<long long>(microseconds_ * static_cast<double>(val))); }
+			E2D_CONSTEXPR_FUNC const Duration operator * (double val) const { return FromMicroseconds(static_cast<long long>(microseconds_ * val)); }
+			E2D_CONSTEXPR_FUNC const Duration operator * (long double val) const { return FromMicroseconds(static_cast<long long>(microseconds_ * val)); }
+			E2D_CONSTEXPR_FUNC const Duration operator / (int val) const { return FromMicroseconds(microseconds_ / val); }
+			E2D_CONSTEXPR_FUNC const Duration operator / (float val) const { return FromMicroseconds(static_cast<long long>(microseconds_ / static_cast<double>(val))); }
+			E2D_CONSTEXPR_FUNC const Duration operator / (double val) const { return FromMicroseconds(static_cast<long long>(microseconds_ / val)); }
+
+			inline Duration& operator += (const Duration & other) { microseconds_ += other.microseconds_; return (*this); }
+			inline Duration& operator -= (const Duration & other) { microseconds_ -= other.microseconds_; return (*this); }
+			inline Duration& operator *= (int val) { microseconds_ *= val; return (*this); }
+			inline Duration& operator *= (float val) { return (*this) = (*this) * val; }
+			inline Duration& operator *= (double val) { return (*this) = (*this) * val; }
+			inline Duration& operator /= (int val) { microseconds_ /= val; return (*this); }
+			inline Duration& operator /= (float val) { return (*this) = (*this) / val; }
+			inline Duration& operator /= (double val) { return (*this) = (*this) / val; }
+
+			friend E2D_CONSTEXPR_FUNC const Duration operator* (int val, const Duration & dur) { return dur * val; }
+			friend E2D_CONSTEXPR_FUNC const Duration operator* (float val, const Duration & dur) { return dur * val; }
+			friend E2D_CONSTEXPR_FUNC const Duration operator* (double val, const Duration & dur) { return dur * val; }
+			friend E2D_CONSTEXPR_FUNC const Duration operator* (long double val, const Duration & dur) { return dur * val; }
+			friend E2D_CONSTEXPR_FUNC const Duration operator/ (int val, const Duration & dur) { return dur / val; }
+			friend E2D_CONSTEXPR_FUNC const Duration operator/ (float val, const Duration & dur) { return dur / val; }
+			friend E2D_CONSTEXPR_FUNC const Duration operator/ (double val, const Duration & dur) { return dur / val; }
 
 			friend std::wostream& operator<< (std::wostream &, const Duration &);
 			friend std::wistream& operator>> (std::wistream &, Duration &);
 
 		private:
-			long milliseconds_;
+			E2D_CONSTEXPR_FUNC Duration(long long microseconds, int)
+				: microseconds_(microseconds)
+			{
+			}
+
+		private:
+			long long microseconds_;
 		};
 
 		/* Ԥʱ */
-		E2D_API extern const Duration Millisecond;	// 
-		E2D_API extern const Duration Second;		// 
-		E2D_API extern const Duration Minute;		// 
-		E2D_API extern const Duration Hour;			// Сʱ
+		E2D_CONSTEXPR Duration Microsecond	= Duration::FromMicroseconds(1LL);			// ΢
+		E2D_CONSTEXPR Duration Millisecond	= Duration::FromMicroseconds(1000LL);		// 
+		E2D_CONSTEXPR Duration Second		= Duration::FromMicroseconds(1000000LL);	// 
+		E2D_CONSTEXPR Duration Minute		= Duration::FromMicroseconds(60000000LL);	// 
+		E2D_CONSTEXPR Duration Hour			= Duration::FromMicroseconds(3600000000LL);	// Сʱ
 
 
 		// ʱ
@@ -125,23 +152,30 @@ namespace easy2d
 		// 
 		struct E2D_API TimePoint
 		{
-			TimePoint();
+			E2D_CONSTEXPR_FUNC TimePoint()
+				: dur_(0)
+			{
+			}
 
-			TimePoint(long);
+			// Ϊ΢
+			explicit E2D_CONSTEXPR_FUNC TimePoint(long long microseconds)
+				: dur_(microseconds)
+			{
+			}
 
 			// Ƿʱ
-			inline bool IsZero() const { return dur_ == 0; }
+			E2D_CONSTEXPR_FUNC bool IsZero() const { return dur_ == 0; }
 
-			const TimePoint operator + (const Duration &) const;
-			const TimePoint operator - (const Duration &) const;
+			E2D_CONSTEXPR_FUNC const TimePoint operator + (const Duration & dur) const { return TimePoint(dur_ + dur.Microseconds()); }
+			E2D_CONSTEXPR_FUNC const TimePoint operator - (const Duration & dur) const { return TimePoint(dur_ - dur.Microseconds()); }
 
-			TimePoint& operator += (const Duration &);
-			TimePoint& operator -= (const Duration &);
+			inline TimePoint& operator += (const Duration & dur) { dur_ += dur.Microseconds(); return (*this); }
+			inline TimePoint& operator -= (const Duration & dur) { dur_ -= dur.Microseconds(); return (*this); }
 
-			const Duration operator - (const TimePoint &) const;
+			E2D_CONSTEXPR_FUNC const Duration operator - (const TimePoint & other) const { return Duration::FromMicroseconds(dur_ - other.dur_); }
 
 		private:
-			long dur_;
+			long long dur_;
 		};
 
 		// ȡǰʱ
@@ -154,8 +188,13 @@ namespace easy2d
 		//
 		// ʱַзŵĸ, Ҵʱ䵥λ׺
 		// : "300ms", "-1.5h", "2h45m"
-		// ʱ䵥λ "ms", "s", "m", "h"
+		// ʱ䵥λ "us", "ms", "s", "m", "h"
+		// ʧʱʱ
 		E2D_API Duration ParseDuration(const std::wstring& parse_str);
+
+		// ʱθʽ (ڴ)
+		// ɹ true
+		E2D_API bool ParseDuration(const wchar_t* str, size_t len, Duration& output);
 	}
 }
 
@@ -170,42 +209,52 @@ namespace easy2d
 {
 	inline namespace literals
 	{
-		inline const easy2d::time::Duration operator "" _ms(long double val)
+		constexpr const easy2d::time::Duration operator "" _us(long double val)
+		{
+			return easy2d::time::Microsecond * val;
+		}
+
+		constexpr const easy2d::time::Duration operator "" _ms(long double val)
 		{
 			return easy2d::time::Millisecond * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _s(long double val)
+		constexpr const easy2d::time::Duration operator "" _s(long double val)
 		{
 			return easy2d::time::Second * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _m(long double val)
+		constexpr const easy2d::time::Duration operator "" _m(long double val)
 		{
 			return easy2d::time::Minute * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _h(long double val)
+		constexpr const easy2d::time::Duration operator "" _h(long double val)
 		{
 			return easy2d::time::Hour * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _ms(unsigned long long val)
+		constexpr const easy2d::time::Duration operator "" _us(unsigned long long val)
+		{
+			return easy2d::time::Microsecond * val;
+		}
+
+		constexpr const easy2d::time::Duration operator "" _ms(unsigned long long val)
 		{
 			return easy2d::time::Millisecond * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _s(unsigned long long val)
+		constexpr const easy2d::time::Duration operator "" _s(unsigned long long val)
 		{
 			return easy2d::time::Second * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _m(unsigned long long val)
+		constexpr const easy2d::time::Duration operator "" _m(unsigned long long val)
 		{
 			return easy2d::time::Minute * val;
 		}
 
-		inline const easy2d::time::Duration operator "" _h(unsigned long long val)
+		constexpr const easy2d::time::Duration operator "" _h(unsigned long long val)
 		{
 			return easy2d::time::Hour * val;
 		}
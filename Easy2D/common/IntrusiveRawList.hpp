@@ -0,0 +1,371 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../macros.h"
+#include "Array.h"
+
+#ifdef E2D_DEBUG
+#	define E2D_DEBUG_CHECK_RAW_LIST(list_ptr) list_ptr->Check()
+#else
+#	define E2D_DEBUG_CHECK_RAW_LIST __noop
+#endif
+
+namespace easy2d
+{
+	template <typename T> class IntrusiveRawList;
+
+	template <typename T>
+	class IntrusiveRawListItem
+	{
+		T* prev_;
+		T* next_;
+
+		template <typename U>
+		friend class IntrusiveRawList;
+
+	public:
+		using ItemType = T;
+
+		IntrusiveRawListItem() : prev_(nullptr), next_(nullptr) {}
+
+		T* PrevItem() const { return prev_; }
+
+		T* NextItem() const { return next_; }
+	};
+
+
+	// ʽ
+	// Ԫ֮ʹָ, ÿԪصһ, ʱ޸ü
+	template <typename T>
+	class IntrusiveRawList
+	{
+		T* first_;
+		T* last_;
+
+	public:
+		class Iterator;
+
+		using ItemType = T;
+
+		IntrusiveRawList() : first_(nullptr), last_(nullptr), iterators_(nullptr) {}
+
+		~IntrusiveRawList()
+		{
+			E2D_ASSERT(!iterators_ && "The list is destroyed during iteration");
+			Clear();
+		}
+
+		T* First() const { return first_; }
+
+		T* Last() const { return last_; }
+
+		bool IsEmpty() const { return !first_; }
+
+		void PushBack(T* child)
+		{
+			E2D_ASSERT(!IsLinked(child) && "The item is already in a list");
+
+			child->Retain();
+			child->prev_ = last_;
+			child->next_ = nullptr;
+
+			if (last_)
+				last_->next_ = child;
+			else
+				first_ = child;
+
+			last_ = child;
+
+			E2D_DEBUG_CHECK_RAW_LIST(this);
+		}
+
+		void PushFront(T* child)
+		{
+			E2D_ASSERT(!IsLinked(child) && "The item is already in a list");
+
+			child->Retain();
+			child->prev_ = nullptr;
+			child->next_ = first_;
+
+			if (first_)
+				first_->prev_ = child;
+			else
+				last_ = child;
+
+			first_ = child;
+
+			E2D_DEBUG_CHECK_RAW_LIST(this);
+		}
+
+		void InsertBefore(T* child, T* before)
+		{
+			E2D_ASSERT(!IsLinked(child) && "The item is already in a list");
+
+			child->Retain();
+			child->prev_ = before->prev_;
+			child->next_ = before;
+
+			if (before->prev_)
+				before->prev_->next_ = child;
+			else
+				first_ = child;
+
+			before->prev_ = child;
+
+			E2D_DEBUG_CHECK_RAW_LIST(this);
+		}
+
+		void InsertAfter(T* child, T* after)
+		{
+			E2D_ASSERT(!IsLinked(child) && "The item is already in a list");
+
+			child->Retain();
+			child->prev_ = after;
+			child->next_ = after->next_;
+
+			if (after->next_)
+				after->next_->prev_ = child;
+			else
+				last_ = child;
+
+			after->next_ = child;
+
+			E2D_DEBUG_CHECK_RAW_LIST(this);
+		}
+
+		void Remove(T* child)
+		{
+#ifdef E2D_DEBUG
+			T* tmp = first_;
+			while (tmp != child)
+			{
+				E2D_ASSERT((tmp != last_) && "The node to be removed is not in this list");
+				tmp = tmp->next_;
+			}
+#endif
+
+			bool released = DetachFromIterators(child);
+
+			if (child->next_)
+				child->next_->prev_ = child->prev_;
+			else
+				last_ = child->prev_;
+
+			if (child->prev_)
+				child->prev_->next_ = child->next_;
+			else
+				first_ = child->next_;
+
+			child->prev_ = nullptr;
+			child->next_ = nullptr;
+
+			E2D_DEBUG_CHECK_RAW_LIST(this);
+
+			if (!released)
+				child->Release();
+		}
+
+		void Clear()
+		{
+			for (Iterator* iter = iterators_; iter; iter = iter->prev_iterator_)
+				iter->next_ = nullptr;
+
+			T* p = first_;
+			first_ = nullptr;
+			last_ = nullptr;
+
+			while (p)
+			{
+				T* tmp = p;
+				p = p->next_;
+
+				bool released = DetachFromIterators(tmp);
+
+				tmp->next_ = nullptr;
+				tmp->prev_ = nullptr;
+
+				if (!released)
+					tmp->Release();
+			}
+		}
+
+		// Ԫ, ޸ü
+		// ڱĵӵǰԪλü
+		template <typename Compare>
+		void Sort(Compare comp)
+		{
+			if (first_ == last_)
+				return;
+
+			Array<T*> items;
+			for (T* p = first_; p; p = p->next_)
+				items.push_back(p);
+
+			std::sort(items.begin(), items.end(), comp);
+
+			T* prev = nullptr;
+			for (T* item : items)
+			{
+				item->prev_ = prev;
+				item->next_ = nullptr;
+
+				if (prev)
+					prev->next_ = item;
+				prev = item;
+			}
+
+			first_ = items.front();
+			last_ = items.back();
+
+			// iterators continue from the new neighbour of their current item
+			for (Iterator* iter = iterators_; iter; iter = iter->prev_iterator_)
+			{
+				if (iter->current_ && !iter->holding_)
+					iter->next_ = iter->reverse_ ? iter->current_->prev_ : iter->current_->next_;
+			}
+
+			E2D_DEBUG_CHECK_RAW_LIST(this);
+		}
+
+	private:
+		bool IsLinked(T* child) const
+		{
+			return child->prev_ || child->next_ || first_ == child;
+		}
+
+		// iterators step over removed items, and keep the current one alive
+		// by taking over the reference of this list
+		bool DetachFromIterators(T* child)
+		{
+			bool released = false;
+			for (Iterator* iter = iterators_; iter; iter = iter->prev_iterator_)
+			{
+				if (iter->next_ == child)
+					iter->next_ = iter->reverse_ ? child->prev_ : child->next_;
+
+				if (iter->current_ == child && !iter->holding_)
+				{
+					iter->holding_ = true;
+
+					if (released)
+						child->Retain();
+					released = true;
+				}
+			}
+			return released;
+		}
+
+#ifdef E2D_DEBUG
+
+		void Check()
+		{
+			if (!first_)
+				return;
+
+			T* p = first_;
+			T* tmp = p;
+			do
+			{
+				tmp = p;
+				p = p->next_;
+
+				if (p)
+				{
+					E2D_ASSERT(p->prev_ == tmp && "Check list failed");
+				}
+				else
+				{
+					E2D_ASSERT(tmp == last_ && "Check list failed");
+				}
+			} while (p);
+		}
+
+#endif
+
+	private:
+		Iterator* iterators_;
+
+	public:
+		// ȫ
+		// пƳԪ, ƳĵǰԪڵǰ֮ǰЧ
+		// ӵԪزһᱻ
+		class Iterator
+		{
+			friend class IntrusiveRawList;
+
+		public:
+			explicit Iterator(IntrusiveRawList& list, bool reverse = false)
+				: list_(list)
+				, current_(reverse ? list.last_ : list.first_)
+				, next_(nullptr)
+				, reverse_(reverse)
+				, holding_(false)
+				, prev_iterator_(list.iterators_)
+			{
+				if (current_)
+					next_ = reverse_ ? current_->prev_ : current_->next_;
+
+				list_.iterators_ = this;
+			}
+
+			~Iterator()
+			{
+				E2D_ASSERT(list_.iterators_ == this && "Iterators must be destroyed in reverse order");
+				list_.iterators_ = prev_iterator_;
+
+				if (holding_)
+					current_->Release();
+			}
+
+			inline T* Get() const			{ return current_; }
+
+			inline T* operator->() const	{ return current_; }
+
+			inline explicit operator bool() const	{ return current_ != nullptr; }
+
+			void Next()
+			{
+				T* current = current_;
+				bool holding = holding_;
+
+				current_ = next_;
+				next_ = current_ ? (reverse_ ? current_->prev_ : current_->next_) : nullptr;
+				holding_ = false;
+
+				if (holding)
+					current->Release();
+			}
+
+		private:
+			Iterator(Iterator const&) = delete;
+
+			Iterator& operator=(Iterator const&) = delete;
+
+		private:
+			IntrusiveRawList&	list_;
+			T*					current_;
+			T*					next_;
+			bool				reverse_;
+			bool				holding_;
+			Iterator*			prev_iterator_;
+		};
+	};
+}
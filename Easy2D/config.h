@@ -19,3 +19,6 @@
 
 //---- Define DirectX version. Defaults to using Direct3D11
 //#define E2D_USE_DIRECTX10
+
+//---- Record E2D_PROFILE_SCOPE trace events for easy2d::Tracer. Defaults to compiling the macros out
+//#define E2D_ENABLE_PROFILING
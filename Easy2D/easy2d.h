@@ -37,6 +37,7 @@
 #include "common/helper.h"
 #include "common/closure.hpp"
 #include "common/IntrusiveList.hpp"
+#include "common/IntrusiveRawList.hpp"
 #include "common/IntrusivePtr.hpp"
 #include "common/ComPtr.hpp"
 #include "common/noncopyable.hpp"
@@ -64,6 +65,8 @@
 #include "base/input.h"
 #include "base/time.h"
 #include "base/logs.h"
+#include "base/FrameProfiler.h"
+#include "base/Trace.h"
 #include "renderer/render.h"
 #include "platform/modules.h"
 #include "platform/Application.h"
@@ -87,9 +87,11 @@
 #if VS_VER >= VS_2015
 #	define E2D_NOEXCEPT noexcept
 #	define E2D_CONSTEXPR constexpr
+#	define E2D_CONSTEXPR_FUNC constexpr
 #else
 #	define E2D_NOEXCEPT throw()
 #	define E2D_CONSTEXPR const
+#	define E2D_CONSTEXPR_FUNC inline
 #endif
 
 
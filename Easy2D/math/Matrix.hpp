@@ -126,6 +126,18 @@ namespace easy2d
 				return *this;
 			}
 
+			inline bool operator ==(const Matrix& other) const
+			{
+				return	_11 == other._11 && _12 == other._12 &&
+						_21 == other._21 && _22 == other._22 &&
+						_31 == other._31 && _32 == other._32;
+			}
+
+			inline bool operator !=(const Matrix& other) const
+			{
+				return !(*this == other);
+			}
+
 			inline float Determinant() const
 			{
 				return (_11 * _22) - (_12 * _21);
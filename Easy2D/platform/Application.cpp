@@ -24,23 +24,54 @@
 #include "../base/input.h"
 #include "../base/Event.hpp"
 #include "../base/AsyncTask.h"
+#include "../base/FrameProfiler.h"
 #include "../renderer/render.h"
 #include "../2d/Scene.h"
 #include "../2d/DebugNode.h"
 #include "../2d/Transition.h"
 #include <windowsx.h>
 #include <imm.h>
+#include <mmsystem.h>
 #include <iostream>
 
 #pragma comment(lib, "imm32.lib")
+#pragma comment(lib, "winmm.lib")
 
 namespace easy2d
 {
+	namespace
+	{
+		// timer that wakes the on-demand loop up
+		const UINT_PTR frame_timer_id = 1;
+
+		inline long long QueryCounter()
+		{
+			LARGE_INTEGER count;
+			::QueryPerformanceCounter(&count);
+			return count.QuadPart;
+		}
+
+		inline long long QueryFrequency()
+		{
+			LARGE_INTEGER freq;
+			::QueryPerformanceFrequency(&freq);
+			return freq.QuadPart;
+		}
+	}
+
 	Application::Application()
 		: end_(true)
 		, inited_(false)
+		, on_demand_(false)
+		, focused_(true)
 		, main_window_(nullptr)
 		, time_scale_(1.f)
+		, idle_interval_(100)
+		, background_interval_(33)
+		, frame_requested_(false)
+		, max_fixed_steps_(5)
+		, frame_rate_limit_(0)
+		, next_frame_time_(0)
 	{
 		::CoInitialize(nullptr);
 
@@ -56,20 +87,31 @@ namespace easy2d
 
 	void Application::Init(const Options& options)
 	{
-		ThrowIfFailed(
-			main_window_->Create(
-				options.title,
-				options.width,
-				options.height,
-				options.icon,
-				options.fullscreen,
-				Application::WndProc
-			)
-		);
+		if (options.headless)
+		{
+			Renderer::Instance().SetHeadlessMode(true);
+			Renderer::Instance().SetSoftwareRendering(options.software);
+			Renderer::Instance().Resize(static_cast<UINT>(options.width), static_cast<UINT>(options.height));
+		}
+		else
+		{
+			ThrowIfFailed(
+				main_window_->Create(
+					options.title,
+					options.width,
+					options.height,
+					options.icon,
+					options.fullscreen,
+					Application::WndProc
+				)
+			);
+		}
 
 		Renderer::Instance().SetClearColor(options.clear_color);
 		Renderer::Instance().SetVSyncEnabled(options.vsync);
 
+		SetOnDemandRendering(options.on_demand);
+
 		Use(&Renderer::Instance());
 		Use(&Input::Instance());
 		Use(&AsyncTaskThread::Instance());
@@ -84,12 +126,14 @@ namespace easy2d
 		OnStart();
 
 		HWND hwnd = main_window_->GetHandle();
+		if (hwnd)
+		{
+			// disable imm
+			::ImmAssociateContext(hwnd, nullptr);
 
-		// disable imm
-		::ImmAssociateContext(hwnd, nullptr);
-
-		// use Application instance in message loop
-		::SetWindowLongPtr(hwnd, GWLP_USERDATA, LONG_PTR(this));
+			// use Application instance in message loop
+			::SetWindowLongPtr(hwnd, GWLP_USERDATA, LONG_PTR(this));
+		}
 
 		inited_ = true;
 	}
@@ -98,6 +142,9 @@ namespace easy2d
 	{
 		HWND hwnd = main_window_->GetHandle();
 
+		if (inited_ && Renderer::Instance().IsHeadless())
+			throw std::exception("Headless applications must be driven by Application::RunFrames");
+
 		if (!hwnd)
 			throw std::exception("Calling Application::Run before Application::Init");
 
@@ -115,6 +162,19 @@ namespace easy2d
 		}
 	}
 
+	void Application::RunFrames(int frames, Duration dt)
+	{
+		if (!inited_)
+			throw std::exception("Calling Application::RunFrames before Application::Init");
+
+		end_ = false;
+		for (int i = 0; i < frames && !end_; ++i)
+		{
+			UpdateFrame(dt);
+			Render();
+		}
+	}
+
 	void Application::Quit()
 	{
 		end_ = true;
@@ -127,6 +187,9 @@ namespace easy2d
 		curr_scene_.Reset();
 		debug_node_.Reset();
 
+		if (frame_rate_limit_ > 0)
+			SetFrameRateLimit(0);
+
 		if (inited_)
 		{
 			inited_ = false;
@@ -211,6 +274,37 @@ namespace easy2d
 		time_scale_ = scale_factor;
 	}
 
+	void Application::SetOnDemandRendering(bool enabled)
+	{
+		on_demand_ = enabled;
+		frame_requested_ = true;
+
+		// either loop needs a paint message to start
+		HWND hwnd = main_window_ ? main_window_->GetHandle() : nullptr;
+		if (hwnd)
+			::InvalidateRect(hwnd, nullptr, FALSE);
+	}
+
+	void Application::SetIdleFrameInterval(Duration interval)
+	{
+		idle_interval_ = interval;
+	}
+
+	void Application::SetBackgroundFrameInterval(Duration interval)
+	{
+		background_interval_ = interval;
+	}
+
+	void Application::RequestFrame()
+	{
+		frame_requested_ = true;
+
+		// wake the loop up if it is waiting for the idle timer
+		HWND hwnd = main_window_ ? main_window_->GetHandle() : nullptr;
+		if (on_demand_ && hwnd)
+			::InvalidateRect(hwnd, nullptr, FALSE);
+	}
+
 	void Application::ShowDebugInfo(bool show)
 	{
 		if (show)
@@ -227,11 +321,123 @@ namespace easy2d
 
 	void Application::Update()
 	{
-		static auto last = time::Now();
-
 		const auto now = time::Now();
-		const auto dt = (now - last) * time_scale_;
-		last = now;
+		const auto dt = last_update_.IsZero() ? Duration{} : now - last_update_;
+		last_update_ = now;
+
+		UpdateFrame(dt);
+	}
+
+	void Application::UpdateFrame(Duration elapsed)
+	{
+		FrameProfiler::Instance().BeginFrame();
+
+		const Duration dt = elapsed * time_scale_;
+
+		// transitions, scene switches and queued functions run once per frame,
+		// even when the accumulator holds less than a whole step
+		UpdateFrameState(dt);
+
+		if (fixed_step_.IsZero())
+		{
+			UpdateScenes(dt);
+			UpdateInput();
+			SetSceneInterpolation(1.f);
+			return;
+		}
+
+		accumulator_ += dt;
+
+		int steps = 0;
+		while (accumulator_ >= fixed_step_ && steps < max_fixed_steps_)
+		{
+			SaveSceneStates();
+			UpdateScenes(fixed_step_);
+
+			accumulator_ -= fixed_step_;
+			++steps;
+		}
+
+		// keep pressed and released keys until a step has seen them
+		if (steps > 0)
+			UpdateInput();
+
+		// drop the time the simulation can't catch up with
+		if (accumulator_ >= fixed_step_)
+			accumulator_ = Duration{};
+
+		SetSceneInterpolation(accumulator_ / fixed_step_);
+	}
+
+	void Application::SaveSceneStates()
+	{
+		if (curr_scene_)
+			curr_scene_->GetTransformCache().SaveState();
+
+		if (next_scene_)
+			next_scene_->GetTransformCache().SaveState();
+	}
+
+	void Application::SetSceneInterpolation(float alpha)
+	{
+		if (curr_scene_)
+			curr_scene_->GetTransformCache().SetInterpolation(alpha);
+
+		if (next_scene_)
+			next_scene_->GetTransformCache().SetInterpolation(alpha);
+	}
+
+	void Application::SetFixedTimeStep(Duration step, int max_steps)
+	{
+		E2D_ASSERT(max_steps > 0 && "The number of steps must be positive");
+
+		fixed_step_ = step;
+		max_fixed_steps_ = std::max(max_steps, 1);
+		accumulator_ = Duration{};
+	}
+
+	void Application::SetFrameRateLimit(int fps)
+	{
+		fps = std::max(fps, 0);
+
+		// sleeping precisely needs a 1 ms system timer
+		if (fps > 0 && frame_rate_limit_ == 0)
+			::timeBeginPeriod(1);
+		else if (fps == 0 && frame_rate_limit_ > 0)
+			::timeEndPeriod(1);
+
+		frame_rate_limit_ = fps;
+		next_frame_time_ = 0;
+	}
+
+	void Application::LimitFrameRate()
+	{
+		if (frame_rate_limit_ <= 0 || Renderer::Instance().IsVSyncEnabled())
+			return;
+
+		const long long freq = QueryFrequency();
+		const long long interval = freq / frame_rate_limit_;
+
+		// sleep through most of the wait and yield the last millisecond
+		long long now = QueryCounter();
+		const long long remaining_ms = (next_frame_time_ - now) * 1000 / freq;
+		if (remaining_ms > 1)
+			::Sleep(static_cast<DWORD>(remaining_ms - 1));
+
+		while ((now = QueryCounter()) < next_frame_time_)
+			::SwitchToThread();
+
+		// a late frame starts a new schedule instead of rushing the next ones
+		if (now - next_frame_time_ > interval)
+			next_frame_time_ = now + interval;
+		else
+			next_frame_time_ += interval;
+	}
+
+	void Application::UpdateFrameState(Duration dt)
+	{
+		auto& profiler = FrameProfiler::Instance();
+		profiler.BeginPhase(FramePhase::Transition);
 
 		if (transition_)
 		{
@@ -254,6 +460,9 @@ namespace easy2d
 			next_scene_ = nullptr;
 		}
 
+		profiler.EndPhase(FramePhase::Transition);
+		profiler.BeginPhase(FramePhase::Functions);
+
 		// perform functions
 		{
 			if (!functions_to_perform_.empty())
@@ -274,6 +483,14 @@ namespace easy2d
 			}
 		}
 
+		profiler.EndPhase(FramePhase::Functions);
+	}
+
+	void Application::UpdateScenes(Duration dt)
+	{
+		auto& profiler = FrameProfiler::Instance();
+		profiler.BeginPhase(FramePhase::SceneUpdate);
+
 		OnUpdate(dt);
 
 		if (curr_scene_)
@@ -285,11 +502,24 @@ namespace easy2d
 		if (debug_node_)
 			debug_node_->Update(dt);
 
+		profiler.EndPhase(FramePhase::SceneUpdate);
+	}
+
+	void Application::UpdateInput()
+	{
+		auto& profiler = FrameProfiler::Instance();
+		profiler.BeginPhase(FramePhase::Input);
+
 		Input::Instance().Update();
+
+		profiler.EndPhase(FramePhase::Input);
 	}
 
 	void Application::Render()
 	{
+		auto& profiler = FrameProfiler::Instance();
+		profiler.BeginPhase(FramePhase::Traversal);
+
 		ThrowIfFailed(
 			Renderer::Instance().BeginDraw()
 		);
@@ -308,15 +538,71 @@ namespace easy2d
 		if (debug_node_)
 			debug_node_->Render();
 
+		profiler.EndPhase(FramePhase::Traversal);
+
+		// submit and present phases are recorded by the renderer
 		ThrowIfFailed(
 			Renderer::Instance().EndDraw()
 		);
+
+		profiler.EndFrame();
+	}
+
+	void Application::UpdateOnDemand()
+	{
+		Update();
+
+		// Update may have switched scenes or changed nodes, so check afterwards
+		if (frame_requested_.exchange(false) || transition_ || debug_node_ || IsSceneDirty())
+		{
+			Render();
+
+			// the scene root keeps the flag for the next walk, nodes below reset it when drawn
+			if (curr_scene_ && !curr_scene_->cache_as_bitmap_)
+				curr_scene_->dirty_cache_ = false;
+		}
+
+		ScheduleFrame();
+	}
+
+	void Application::ScheduleFrame()
+	{
+		HWND hwnd = main_window_->GetHandle();
+
+		bool busy = frame_requested_ || transition_ || next_scene_ || debug_node_ ||
+			!functions_to_perform_.empty() || IsSceneDirty() ||
+			(curr_scene_ && curr_scene_->IsAwake());
+
+		Duration interval = busy ? Duration{} : idle_interval_;
+		if (!focused_ && interval < background_interval_)
+			interval = background_interval_;
+
+		if (interval.IsZero())
+		{
+			::InvalidateRect(hwnd, nullptr, FALSE);
+		}
+		else
+		{
+			::SetTimer(hwnd, frame_timer_id, static_cast<UINT>(interval.Milliseconds()), nullptr);
+		}
+	}
+
+	bool Application::IsSceneDirty() const
+	{
+		// changes below the scene walk up to it and mark the root
+		return curr_scene_ && (curr_scene_->dirty_bounds_ || curr_scene_->dirty_cache_);
 	}
 
 	void Application::PreformFunctionInMainThread(std::function<void()> function)
 	{
-		std::lock_guard<std::mutex> lock(perform_mutex_);
-		functions_to_perform_.push(function);
+		{
+			std::lock_guard<std::mutex> lock(perform_mutex_);
+			functions_to_perform_.push(function);
+		}
+
+		HWND hwnd = main_window_ ? main_window_->GetHandle() : nullptr;
+		if (on_demand_ && hwnd)
+			::InvalidateRect(hwnd, nullptr, FALSE);
 	}
 
 	void Application::ShowConsole(bool show)
@@ -392,14 +678,34 @@ namespace easy2d
 		{
 		case WM_PAINT:
 		{
+			if (app->on_demand_)
+			{
+				::ValidateRect(hwnd, nullptr);
+				app->UpdateOnDemand();
+				app->LimitFrameRate();
+				return 0;
+			}
+
 			app->Update();
 			app->Render();
+			app->LimitFrameRate();
 
 			::InvalidateRect(hwnd, NULL, FALSE);
 			return 0;
 		}
 		break;
 
+		case WM_TIMER:
+		{
+			if (wparam == frame_timer_id)
+			{
+				::KillTimer(hwnd, frame_timer_id);
+				::InvalidateRect(hwnd, nullptr, FALSE);
+				return 0;
+			}
+		}
+		break;
+
 		case WM_KEYDOWN:
 		case WM_SYSKEYDOWN:
 		case WM_KEYUP:
@@ -408,6 +714,9 @@ namespace easy2d
 			bool down = msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN;
 			Input::Instance().UpdateKey((int)wparam, down);
 
+			if (app->on_demand_)
+				app->RequestFrame();
+
 			if (!app->transition_ && app->curr_scene_)
 			{
 				Event evt(down ? Event::KeyDown : Event::KeyUp);
@@ -421,6 +730,9 @@ namespace easy2d
 
 		case WM_CHAR:
 		{
+			if (app->on_demand_)
+				app->RequestFrame();
+
 			if (!app->transition_ && app->curr_scene_)
 			{
 				Event evt(Event::Char);
@@ -448,6 +760,9 @@ namespace easy2d
 			else if (msg == WM_RBUTTONDOWN || msg == WM_RBUTTONUP) { Input::Instance().UpdateKey(VK_RBUTTON, (msg == WM_RBUTTONDOWN) ? true : false); }
 			else if (msg == WM_MBUTTONDOWN || msg == WM_MBUTTONUP) { Input::Instance().UpdateKey(VK_MBUTTON, (msg == WM_MBUTTONDOWN) ? true : false); }
 
+			if (app->on_demand_)
+				app->RequestFrame();
+
 			if (!app->transition_ && app->curr_scene_)
 			{
 				Event evt;
@@ -486,6 +801,9 @@ namespace easy2d
 
 			Renderer::Instance().Resize(width, height);
 
+			if (app->on_demand_)
+				app->RequestFrame();
+
 			if (SIZE_MAXHIDE == wparam || SIZE_MINIMIZED == wparam)
 			{
 				E2D_LOG(L"Window minimized");
@@ -530,6 +848,10 @@ namespace easy2d
 
 			app->GetWindow()->SetActive(active);
 
+			app->focused_ = active;
+			if (app->on_demand_)
+				app->RequestFrame();
+
 			if (app->curr_scene_)
 			{
 				Event evt(Event::WindowFocusChanged);
@@ -24,6 +24,7 @@
 #include "../base/window.h"
 #include "../base/Component.h"
 #include <mutex>
+#include <atomic>
 
 namespace easy2d
 {
@@ -36,6 +37,9 @@ namespace easy2d
 		Color	clear_color;		// ɫ
 		bool	vsync;				// ֱͬ
 		bool	fullscreen;			// ȫģʽ
+		bool	headless;			// ޴ģʽ, ʹ RunFrames 
+		bool	software;			// ޴ģʽ CPU Ⱦڴλͼ
+		bool	on_demand;			// Ⱦ, ûб仯ʱ»
 
 		Options(
 			String const& title = L"Easy2D Game",
@@ -44,7 +48,10 @@ namespace easy2d
 			LPCWSTR icon = nullptr,
 			Color clear_color = Color::Black,
 			bool vsync = true,
-			bool fullscreen = false
+			bool fullscreen = false,
+			bool headless = false,
+			bool software = false,
+			bool on_demand = false
 		)
 			: title(title)
 			, width(width)
@@ -53,6 +60,9 @@ namespace easy2d
 			, clear_color(clear_color)
 			, vsync(vsync)
 			, fullscreen(fullscreen)
+			, headless(headless)
+			, software(software)
+			, on_demand(on_demand)
 		{}
 	};
 
@@ -88,6 +98,13 @@ namespace easy2d
 		// 
 		void Run();
 
+		// Թ̶ʱָ֡, Ϣ
+		// ޴ģʽг߼ܲ
+		void RunFrames(
+			int frames,
+			Duration dt
+		);
+
 		// 
 		void Quit();
 
@@ -126,6 +143,43 @@ namespace easy2d
 			float scale_factor
 		);
 
+		// ù̶ʱ䲽, Ϊʱÿ֡ʵʾʱ (Ĭ)
+		// ÿ֡ಹ max_steps θ, ʱʣʱ
+		// Ⱦʱڵı任θµ״ֵ̬֮
+		void SetFixedTimeStep(
+			Duration step,
+			int max_steps = 5
+		);
+
+		// ֡, Ϊʱ (Ĭ)
+		// ֻڹرմֱͬʱЧ
+		void SetFrameRateLimit(
+			int fps
+		);
+
+		// رհȾ
+		// , ûб仯ʱȾ, л򴰿ʧȥʱ͸Ƶ
+		void SetOnDemandRendering(
+			bool enabled
+		);
+
+		// ÿʱĸ¼, Ĭ 100 
+		void SetIdleFrameInterval(
+			Duration interval
+		);
+
+		// ôʧȥʱĸ¼, Ĭ 33 
+		void SetBackgroundFrameInterval(
+			Duration interval
+		);
+
+		// Ⱦһ֡
+		// Ⱦʱ, ޷֪Ļ仯 ( OnRender лƵ) Ҫøú
+		void RequestFrame();
+
+		// ǷȾ
+		inline bool IsOnDemandRendering() const { return on_demand_; }
+
 		// ʾϢ
 		void ShowDebugInfo(
 			bool show = true
@@ -147,12 +201,57 @@ namespace easy2d
 
 		void Update();
 
+		// ÿִ֡һ: , л, ̺߳
+		void UpdateFrameState(
+			Duration dt
+		);
+
+		// ³, ̶ʱÿִ֡ж
+		void UpdateScenes(
+			Duration dt
+		);
+
+		void UpdateInput();
+
+		// һ֡, ̶ʱִжθ
+		void UpdateFrame(
+			Duration elapsed
+		);
+
+		void SaveSceneStates();
+
+		void SetSceneInterpolation(
+			float alpha
+		);
+
+		// رմֱͬʱ, ȴһ֡Ŀʼʱ
+		void LimitFrameRate();
+
+		// Ⱦʱһ֡, б仯ʱȾ
+		void UpdateOnDemand();
+
+		// Ⱦʱһ֡
+		void ScheduleFrame();
+
+		bool IsSceneDirty() const;
+
 		static LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
 
 	protected:
 		bool			end_;
 		bool			inited_;
+		bool			on_demand_;
+		bool			focused_;
 		float			time_scale_;
+		Duration		idle_interval_;
+		Duration		background_interval_;
+		std::atomic<bool>	frame_requested_;
+		int				max_fixed_steps_;
+		int				frame_rate_limit_;
+		long long		next_frame_time_;
+		Duration		fixed_step_;
+		Duration		accumulator_;
+		TimePoint		last_update_;
 
 		ScenePtr		curr_scene_;
 		ScenePtr		next_scene_;
@@ -86,6 +86,7 @@ namespace easy2d
 		d2d_device_.Reset();
 		d2d_device_context_.Reset();
 		d2d_target_bitmap_.Reset();
+		wic_target_bitmap_.Reset();
 
 		imaging_factory_.Reset();
 		dwrite_factory_.Reset();
@@ -224,6 +225,58 @@ namespace easy2d
 			d2d_device_context_->SetTarget(d2d_target_bitmap_.Get());
 	}
 
+	HRESULT D2DDeviceResources::CreateSoftwareTarget(UINT width, UINT height)
+	{
+		if (!imaging_factory_ || !d2d_factory_)
+			return E_UNEXPECTED;
+
+		ComPtr<IWICBitmap>			wic_bitmap;
+		ComPtr<ID2D1RenderTarget>	render_target;
+		ComPtr<ID2D1DeviceContext>	device_ctx;
+
+		HRESULT hr = imaging_factory_->CreateBitmap(
+			std::max(width, 1U),
+			std::max(height, 1U),
+			GUID_WICPixelFormat32bppPBGRA,
+			WICBitmapCacheOnLoad,
+			&wic_bitmap
+		);
+
+		if (SUCCEEDED(hr))
+		{
+			// a software render target never touches the GPU
+			hr = d2d_factory_->CreateWicBitmapRenderTarget(
+				wic_bitmap.Get(),
+				D2D1::RenderTargetProperties(
+					D2D1_RENDER_TARGET_TYPE_SOFTWARE,
+					D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED),
+					dpi_,
+					dpi_
+				),
+				&render_target
+			);
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			// render targets created by a Direct2D 1.1 factory are device contexts
+			hr = render_target->QueryInterface(IID_PPV_ARGS(&device_ctx));
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			// cached bitmaps belong to the previous target
+			ClearImageCache();
+
+			d2d_device_.Reset();
+			d2d_target_bitmap_.Reset();
+			d2d_device_context_ = device_ctx;
+			wic_target_bitmap_ = wic_bitmap;
+		}
+
+		return hr;
+	}
+
 	HRESULT D2DDeviceResources::CreateBitmapFromFile(ComPtr<ID2D1Bitmap> & bitmap, String const & file_path)
 	{
 		if (!imaging_factory_ || !d2d_device_context_)
@@ -69,12 +69,19 @@ namespace easy2d
 			_In_ ComPtr<ID2D1Bitmap1> const& target
 		);
 
+		//  WIC λͼΪĿȾ,  CPU ɻ
+		HRESULT CreateSoftwareTarget(
+			_In_ UINT width,
+			_In_ UINT height
+		);
+
 		inline ID2D1Factory1*			GetD2DFactory() const			{ return d2d_factory_.Get(); }
 		inline IWICImagingFactory*		GetWICImagingFactory() const	{ return imaging_factory_.Get(); }
 		inline IDWriteFactory*			GetDWriteFactory() const		{ return dwrite_factory_.Get(); }
 		inline ID2D1Device*				GetD2DDevice() const			{ return d2d_device_.Get(); }
 		inline ID2D1DeviceContext*		GetD2DDeviceContext() const		{ return d2d_device_context_.Get(); }
 		inline ID2D1Bitmap1*			GetD2DTargetBitmap() const		{ return d2d_target_bitmap_.Get(); }
+		inline IWICBitmap*				GetWICTargetBitmap() const		{ return wic_target_bitmap_.Get(); }
 
 		ID2D1StrokeStyle*				GetStrokeStyle(StrokeStyle stroke) const;
 
@@ -106,6 +113,7 @@ namespace easy2d
 		ComPtr<ID2D1Device>			d2d_device_;
 		ComPtr<ID2D1DeviceContext>	d2d_device_context_;
 		ComPtr<ID2D1Bitmap1>		d2d_target_bitmap_;
+		ComPtr<IWICBitmap>			wic_target_bitmap_;
 
 		ComPtr<IWICImagingFactory>	imaging_factory_;
 		ComPtr<IDWriteFactory>		dwrite_factory_;
@@ -75,7 +75,8 @@ namespace easy2d
 			{
 				hr = res->CreateDeviceIndependentResources();
 
-				if (SUCCEEDED(hr))
+				// without a window only device independent resources are created
+				if (SUCCEEDED(hr) && hwnd)
 				{
 					RECT rc;
 					GetClientRect(hwnd, &rc);
@@ -87,7 +88,7 @@ namespace easy2d
 					hr = res->CreateDeviceResources();
 				}
 
-				if (SUCCEEDED(hr))
+				if (SUCCEEDED(hr) && hwnd)
 				{
 					hr = res->CreateWindowSizeDependentResources();
 				}
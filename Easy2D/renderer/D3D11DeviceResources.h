@@ -32,6 +32,7 @@ namespace easy2d
 		: public D2DDeviceResources
 	{
 	public:
+		// hwnd Ϊʱֻ豸޹صԴ
 		static HRESULT Create(
 			D3D11DeviceResources** device_resources,
 			HWND hwnd
@@ -0,0 +1,229 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "PixelBuffer.h"
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#	define E2D_PIXEL_SSE2
+#	include <emmintrin.h>
+#endif
+
+namespace easy2d
+{
+	namespace
+	{
+		// swaps the red and blue channels, BGRA <-> RGBA
+		inline std::uint32_t SwapRedBlue(std::uint32_t p)
+		{
+			return (p & 0xFF00FF00u) | ((p >> 16) & 0xFFu) | ((p & 0xFFu) << 16);
+		}
+
+		inline int ChannelDifference(std::uint32_t a, std::uint32_t b)
+		{
+			int max_diff = 0;
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				int diff = static_cast<int>((a >> shift) & 0xFFu) - static_cast<int>((b >> shift) & 0xFFu);
+				max_diff = std::max(max_diff, diff < 0 ? -diff : diff);
+			}
+			return max_diff;
+		}
+	}
+
+	PixelBuffer::PixelBuffer()
+		: width_(0)
+		, height_(0)
+	{
+	}
+
+	PixelBuffer::PixelBuffer(int width, int height)
+		: PixelBuffer()
+	{
+		Resize(width, height);
+	}
+
+	void PixelBuffer::Resize(int width, int height)
+	{
+		width_ = std::max(width, 0);
+		height_ = std::max(height, 0);
+		pixels_.resize(static_cast<size_t>(width_) * height_);
+	}
+
+	void PixelBuffer::Clear(std::uint32_t rgba)
+	{
+		std::fill(pixels_.begin(), pixels_.end(), rgba);
+	}
+
+	void PixelBuffer::CopyFromBGRA(void const* src, int src_stride)
+	{
+		for (int y = 0; y < height_; ++y)
+		{
+			auto src_row = reinterpret_cast<std::uint32_t const*>(static_cast<unsigned char const*>(src) + y * src_stride);
+			auto dest_row = &pixels_[y * width_];
+
+			int x = 0;
+#if defined(E2D_PIXEL_SSE2)
+			const __m128i mask_ag = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+			const __m128i mask_low = _mm_set1_epi32(0x000000FF);
+			for (; x + 4 <= width_; x += 4)
+			{
+				__m128i p = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src_row + x));
+				__m128i ag = _mm_and_si128(p, mask_ag);
+				__m128i r = _mm_and_si128(_mm_srli_epi32(p, 16), mask_low);
+				__m128i b = _mm_slli_epi32(_mm_and_si128(p, mask_low), 16);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dest_row + x), _mm_or_si128(ag, _mm_or_si128(r, b)));
+			}
+#endif
+			for (; x < width_; ++x)
+			{
+				dest_row[x] = SwapRedBlue(src_row[x]);
+			}
+		}
+	}
+
+	PixelBuffer::Difference PixelBuffer::Compare(PixelBuffer const& a, PixelBuffer const& b, int tolerance)
+	{
+		Difference result = { 0, 0 };
+
+		if (a.width_ != b.width_ || a.height_ != b.height_)
+		{
+			// images of different sizes differ everywhere
+			result.pixels = std::max(a.width_ * a.height_, b.width_ * b.height_);
+			result.max_channel = 255;
+			return result;
+		}
+
+		tolerance = std::min(std::max(tolerance, 0), 255);
+
+		const int count = a.width_ * a.height_;
+		int i = 0;
+
+#if defined(E2D_PIXEL_SSE2)
+		const __m128i tol = _mm_set1_epi8(static_cast<char>(tolerance));
+		const __m128i zero = _mm_setzero_si128();
+		__m128i max_diff = zero;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i pa = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&a.pixels_[i]));
+			__m128i pb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&b.pixels_[i]));
+
+			// per-channel absolute difference with saturating subtraction
+			__m128i diff = _mm_or_si128(_mm_subs_epu8(pa, pb), _mm_subs_epu8(pb, pa));
+			max_diff = _mm_max_epu8(max_diff, diff);
+
+			// a pixel differs when any channel exceeds the tolerance
+			__m128i over = _mm_subs_epu8(diff, tol);
+			int same = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(over, zero)));
+			result.pixels += 4 - ((same & 1) + ((same >> 1) & 1) + ((same >> 2) & 1) + ((same >> 3) & 1));
+		}
+
+		unsigned char lanes[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), max_diff);
+		for (int lane = 0; lane < 16; ++lane)
+		{
+			result.max_channel = std::max(result.max_channel, static_cast<int>(lanes[lane]));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			int diff = ChannelDifference(a.pixels_[i], b.pixels_[i]);
+			result.max_channel = std::max(result.max_channel, diff);
+			if (diff > tolerance)
+				++result.pixels;
+		}
+		return result;
+	}
+
+	bool PixelBuffer::SaveToFile(char const* file_path) const
+	{
+		std::ofstream file(file_path, std::ios::binary);
+		if (!file)
+			return false;
+
+		file << "P7\nWIDTH " << width_ << "\nHEIGHT " << height_
+			<< "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+
+		// pixels are stored as bytes in R, G, B, A order
+		for (int y = 0; y < height_; ++y)
+		{
+			for (int x = 0; x < width_; ++x)
+			{
+				std::uint32_t p = GetPixel(x, y);
+				char bytes[4] = {
+					static_cast<char>(p & 0xFFu),
+					static_cast<char>((p >> 8) & 0xFFu),
+					static_cast<char>((p >> 16) & 0xFFu),
+					static_cast<char>((p >> 24) & 0xFFu)
+				};
+				file.write(bytes, 4);
+			}
+		}
+		return !!file;
+	}
+
+	bool PixelBuffer::LoadFromFile(char const* file_path)
+	{
+		std::ifstream file(file_path, std::ios::binary);
+		if (!file)
+			return false;
+
+		std::string token;
+		int width = -1, height = -1, depth = 0, maxval = 0;
+
+		file >> token;
+		if (token != "P7")
+			return false;
+
+		while (file >> token && token != "ENDHDR")
+		{
+			if (token == "WIDTH")
+				file >> width;
+			else if (token == "HEIGHT")
+				file >> height;
+			else if (token == "DEPTH")
+				file >> depth;
+			else if (token == "MAXVAL")
+				file >> maxval;
+			else if (token == "TUPLTYPE")
+				file >> token;
+		}
+
+		if (!file || width < 0 || height < 0 || depth != 4 || maxval != 255)
+			return false;
+
+		// skip the newline after ENDHDR
+		file.get();
+
+		Resize(width, height);
+		for (auto& p : pixels_)
+		{
+			unsigned char bytes[4];
+			if (!file.read(reinterpret_cast<char*>(bytes), 4))
+				return false;
+
+			p = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+		}
+		return true;
+	}
+}
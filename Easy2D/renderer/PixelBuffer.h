@@ -0,0 +1,94 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../macros.h"
+#include "../common/Array.h"
+#include <cstdint>
+
+namespace easy2d
+{
+	// ػ
+	// ÿΪԤ alpha  RGBA8, 洢, ڶȡȾͱȽ֡ͼ
+	class E2D_API PixelBuffer
+	{
+	public:
+		// ͼĲ
+		struct Difference
+		{
+			int pixels;			// ݲ
+			int max_channel;	// ֵͨ
+		};
+
+		PixelBuffer();
+
+		PixelBuffer(
+			int width,
+			int height
+		);
+
+		// ıС, ԭݲ
+		void Resize(
+			int width,
+			int height
+		);
+
+		// ɫ, rgba ֽΪɫ
+		void Clear(
+			std::uint32_t rgba
+		);
+
+		// Ԥ alpha  BGRA8 ظ, С뻺ͬ
+		void CopyFromBGRA(
+			void const* src,
+			int src_stride
+		);
+
+		// ȽСͬͼ, һֵͨ tolerance ؼΪͬ
+		static Difference Compare(
+			PixelBuffer const& a,
+			PixelBuffer const& b,
+			int tolerance
+		);
+
+		// Ϊ PAM ʽ (RGB_ALPHA)
+		bool SaveToFile(
+			char const* file_path
+		) const;
+
+		// ȡ SaveToFile  PAM ļ
+		bool LoadFromFile(
+			char const* file_path
+		);
+
+		inline int					GetWidth() const				{ return width_; }
+
+		inline int					GetHeight() const				{ return height_; }
+
+		inline std::uint32_t const*	GetData() const					{ return pixels_.empty() ? nullptr : &pixels_[0]; }
+
+		inline std::uint32_t		GetPixel(int x, int y) const	{ return pixels_[y * width_ + x]; }
+
+	private:
+		int width_;
+		int height_;
+		Array<std::uint32_t> pixels_;
+	};
+}
@@ -0,0 +1,292 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "RenderCommandList.h"
+
+namespace easy2d
+{
+	namespace
+	{
+		// how far back an image may move to join a draw of the same bitmap
+		const int sort_window = 64;
+
+		inline Rect GetImageBounds(RenderCommandList::ImageData const& image)
+		{
+			// antialiased edges may bleed one pixel out of the bounds
+			Rect bounds = image.transform.Transform(image.dest);
+			return Rect{ bounds.origin.x - 1.f, bounds.origin.y - 1.f, bounds.size.x + 2.f, bounds.size.y + 2.f };
+		}
+	}
+
+	RenderCommandList::RenderCommandList()
+		: opacity_(1.f)
+		, committed_opacity_(1.f)
+		, transform_committed_(false)
+		, opacity_committed_(false)
+	{
+	}
+
+	void RenderCommandList::SetTransform(Matrix const& matrix)
+	{
+		transform_ = matrix;
+	}
+
+	void RenderCommandList::SetOpacity(float opacity)
+	{
+		opacity_ = opacity;
+	}
+
+	void RenderCommandList::SetTextStyle(TextStyleData const& style)
+	{
+		AddCommand(CommandType::TextStyle, static_cast<int>(text_styles_.size()));
+		text_styles_.push_back(style);
+	}
+
+	void RenderCommandList::SetAntialiasMode(bool enabled)
+	{
+		AddCommand(CommandType::Antialias, static_cast<int>(antialias_modes_.size()));
+		antialias_modes_.push_back(enabled);
+	}
+
+	void RenderCommandList::SetTextAntialiasMode(TextAntialias mode)
+	{
+		AddCommand(CommandType::TextAntialias, static_cast<int>(text_antialias_modes_.size()));
+		text_antialias_modes_.push_back(mode);
+	}
+
+	void RenderCommandList::PushClip(Matrix const& clip_matrix, Size const& clip_size)
+	{
+		ClipData clip;
+		clip.matrix = clip_matrix;
+		clip.size = clip_size;
+
+		AddCommand(CommandType::PushClip, static_cast<int>(clips_.size()));
+		clips_.push_back(clip);
+
+		// the clip replaces the transform of the device context
+		transform_committed_ = false;
+	}
+
+	void RenderCommandList::PopClip()
+	{
+		AddCommand(CommandType::PopClip, 0);
+	}
+
+	void RenderCommandList::PushLayer(ComPtr<ID2D1Layer> const& layer, LayerProperties const& properties)
+	{
+		CommitState();
+
+		LayerData data;
+		data.layer = layer;
+		data.properties = properties;
+
+		AddCommand(CommandType::PushLayer, static_cast<int>(layers_.size()));
+		layers_.push_back(data);
+	}
+
+	void RenderCommandList::PopLayer()
+	{
+		AddCommand(CommandType::PopLayer, 0);
+	}
+
+	void RenderCommandList::PushTarget(ComPtr<ID2D1Bitmap1> const& target)
+	{
+		AddCommand(CommandType::PushTarget, static_cast<int>(targets_.size()));
+		targets_.push_back(target);
+	}
+
+	void RenderCommandList::PopTarget()
+	{
+		AddCommand(CommandType::PopTarget, 0);
+	}
+
+	void RenderCommandList::DrawImage(ComPtr<ID2D1Bitmap> const& bitmap, void const* key, Rect const& dest_rect, Rect const& src_rect)
+	{
+		ImageData image;
+		image.bitmap = bitmap;
+		image.key = key;
+		image.dest = dest_rect;
+		image.src = src_rect;
+		image.transform = transform_;
+		image.opacity = opacity_;
+
+		AddCommand(CommandType::Image, static_cast<int>(images_.size()));
+		images_.push_back(image);
+	}
+
+	void RenderCommandList::DrawBitmap(ComPtr<ID2D1Bitmap> const& bitmap)
+	{
+		CommitState();
+
+		AddCommand(CommandType::Bitmap, static_cast<int>(bitmaps_.size()));
+		bitmaps_.push_back(bitmap);
+	}
+
+	void RenderCommandList::DrawGeometry(ComPtr<ID2D1Geometry> const& geometry, Color const& stroke_color, float stroke_width, StrokeStyle stroke)
+	{
+		CommitState();
+
+		GeometryData data;
+		data.geometry = geometry;
+		data.color = stroke_color;
+		data.stroke_width = stroke_width;
+		data.stroke = stroke;
+
+		AddCommand(CommandType::Geometry, static_cast<int>(geometries_.size()));
+		geometries_.push_back(data);
+	}
+
+	void RenderCommandList::FillGeometry(ComPtr<ID2D1Geometry> const& geometry, Color const& fill_color)
+	{
+		CommitState();
+
+		GeometryData data;
+		data.geometry = geometry;
+		data.color = fill_color;
+		data.stroke_width = 0.f;
+		data.stroke = StrokeStyle::Miter;
+
+		AddCommand(CommandType::FillGeometry, static_cast<int>(geometries_.size()));
+		geometries_.push_back(data);
+	}
+
+	void RenderCommandList::DrawTextLayout(ComPtr<IDWriteTextLayout> const& text_layout)
+	{
+		CommitState();
+
+		AddCommand(CommandType::Text, static_cast<int>(text_layouts_.size()));
+		text_layouts_.push_back(text_layout);
+	}
+
+	void RenderCommandList::SortImages()
+	{
+		Array<int> order;
+		Array<Rect> bounds;
+
+		const int count = GetCount();
+		int begin = 0;
+		while (begin < count)
+		{
+			if (commands_[begin].type != CommandType::Image)
+			{
+				++begin;
+				continue;
+			}
+
+			int end = begin + 1;
+			while (end < count && commands_[end].type == CommandType::Image)
+				++end;
+
+			if (end - begin > 1)
+			{
+				order.resize(0);
+				bounds.resize(0);
+
+				for (int i = begin; i < end; ++i)
+				{
+					const int index = commands_[i].index;
+					ImageData const& image = images_[index];
+					Rect image_bounds = GetImageBounds(image);
+
+					// move the image back to the last draw of the same bitmap,
+					// unless it would pass over something it overlaps
+					int pos = static_cast<int>(order.size());
+					for (int k = pos - 1; k >= 0 && pos - k <= sort_window; --k)
+					{
+						if (images_[order[k]].key == image.key)
+						{
+							pos = k + 1;
+							break;
+						}
+
+						if (bounds[k].Intersects(image_bounds))
+							break;
+					}
+
+					order.push_back(index);
+					bounds.push_back(image_bounds);
+					for (int k = static_cast<int>(order.size()) - 1; k > pos; --k)
+					{
+						order[k] = order[k - 1];
+						bounds[k] = bounds[k - 1];
+					}
+					order[pos] = index;
+					bounds[pos] = image_bounds;
+				}
+
+				for (int i = begin; i < end; ++i)
+				{
+					commands_[i].index = order[i - begin];
+				}
+			}
+			begin = end;
+		}
+	}
+
+	void RenderCommandList::Clear()
+	{
+		transform_ = Matrix{};
+		opacity_ = 1.f;
+		transform_committed_ = false;
+		opacity_committed_ = false;
+
+		commands_.resize(0);
+		transforms_.resize(0);
+		opacities_.resize(0);
+		text_styles_.resize(0);
+		antialias_modes_.resize(0);
+		text_antialias_modes_.resize(0);
+		clips_.resize(0);
+		layers_.resize(0);
+		targets_.resize(0);
+		images_.resize(0);
+		bitmaps_.resize(0);
+		geometries_.resize(0);
+		text_layouts_.resize(0);
+	}
+
+	void RenderCommandList::AddCommand(CommandType type, int index)
+	{
+		Command command;
+		command.type = type;
+		command.index = index;
+		commands_.push_back(command);
+	}
+
+	void RenderCommandList::CommitState()
+	{
+		// only state that differs from what the previous draws used is recorded
+		if (!transform_committed_ || transform_ != committed_transform_)
+		{
+			AddCommand(CommandType::Transform, static_cast<int>(transforms_.size()));
+			transforms_.push_back(transform_);
+			committed_transform_ = transform_;
+			transform_committed_ = true;
+		}
+
+		if (!opacity_committed_ || opacity_ != committed_opacity_)
+		{
+			AddCommand(CommandType::Opacity, static_cast<int>(opacities_.size()));
+			opacities_.push_back(opacity_);
+			committed_opacity_ = opacity_;
+			opacity_committed_ = true;
+		}
+	}
+}
@@ -0,0 +1,237 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../2d/include-forwards.h"
+#include "helper.hpp"
+#include <d2d1_1.h>
+#include <dwrite.h>
+
+namespace easy2d
+{
+	// Ⱦб
+	// ڵʱֻ¼, Ⱦ EndDraw ʱͳһִ
+	// 任Ͳ͸ҪʱŻд, ͼƬԴ任Ͳ͸
+	class E2D_API RenderCommandList
+	{
+	public:
+		enum class CommandType : unsigned char
+		{
+			Transform,
+			Opacity,
+			TextStyle,
+			Antialias,
+			TextAntialias,
+			PushClip,
+			PopClip,
+			PushLayer,
+			PopLayer,
+			PushTarget,
+			PopTarget,
+			Image,
+			Bitmap,
+			Geometry,
+			FillGeometry,
+			Text
+		};
+
+		// , index ΪӦݵ±
+		struct Command
+		{
+			CommandType	type;
+			int			index;
+		};
+
+		struct ImageData
+		{
+			ComPtr<ID2D1Bitmap>	bitmap;
+			void const*			key;		// λͼʶ, ں
+			Rect				dest;
+			Rect				src;
+			Matrix				transform;
+			float				opacity;
+		};
+
+		struct GeometryData
+		{
+			ComPtr<ID2D1Geometry>	geometry;
+			Color					color;
+			float					stroke_width;
+			StrokeStyle				stroke;
+		};
+
+		struct TextStyleData
+		{
+			Color		color;
+			bool		has_outline;
+			Color		outline_color;
+			float		outline_width;
+			StrokeStyle	outline_stroke;
+		};
+
+		struct ClipData
+		{
+			Matrix	matrix;
+			Size	size;
+		};
+
+		struct LayerData
+		{
+			ComPtr<ID2D1Layer>	layer;
+			LayerProperties		properties;
+		};
+
+	public:
+		RenderCommandList();
+
+		void SetTransform(
+			Matrix const& matrix
+		);
+
+		void SetOpacity(
+			float opacity
+		);
+
+		void SetTextStyle(
+			TextStyleData const& style
+		);
+
+		void SetAntialiasMode(
+			bool enabled
+		);
+
+		void SetTextAntialiasMode(
+			TextAntialias mode
+		);
+
+		void PushClip(
+			Matrix const& clip_matrix,
+			Size const& clip_size
+		);
+
+		void PopClip();
+
+		void PushLayer(
+			ComPtr<ID2D1Layer> const& layer,
+			LayerProperties const& properties
+		);
+
+		void PopLayer();
+
+		// лĿ, ֮Ƶλͼ
+		void PushTarget(
+			ComPtr<ID2D1Bitmap1> const& target
+		);
+
+		void PopTarget();
+
+		void DrawImage(
+			ComPtr<ID2D1Bitmap> const& bitmap,
+			void const* key,
+			Rect const& dest_rect,
+			Rect const& src_rect
+		);
+
+		void DrawBitmap(
+			ComPtr<ID2D1Bitmap> const& bitmap
+		);
+
+		void DrawGeometry(
+			ComPtr<ID2D1Geometry> const& geometry,
+			Color const& stroke_color,
+			float stroke_width,
+			StrokeStyle stroke
+		);
+
+		void FillGeometry(
+			ComPtr<ID2D1Geometry> const& geometry,
+			Color const& fill_color
+		);
+
+		void DrawTextLayout(
+			ComPtr<IDWriteTextLayout> const& text_layout
+		);
+
+		// ͼƬ, ʹͬһλͼҲıڵϵһ
+		void SortImages();
+
+		// , ѷڴ
+		void Clear();
+
+		inline int						GetCount() const					{ return static_cast<int>(commands_.size()); }
+
+		inline Command const&			GetCommand(int index) const			{ return commands_[index]; }
+
+		inline Matrix const&			GetTransform(int index) const		{ return transforms_[index]; }
+
+		inline float					GetOpacity(int index) const			{ return opacities_[index]; }
+
+		inline TextStyleData const&		GetTextStyle(int index) const		{ return text_styles_[index]; }
+
+		inline bool						GetAntialiasMode(int index) const	{ return antialias_modes_[index]; }
+
+		inline TextAntialias			GetTextAntialiasMode(int index) const	{ return text_antialias_modes_[index]; }
+
+		inline ClipData const&			GetClip(int index) const			{ return clips_[index]; }
+
+		inline LayerData const&			GetLayer(int index) const			{ return layers_[index]; }
+
+		inline ComPtr<ID2D1Bitmap1> const&	GetTarget(int index) const		{ return targets_[index]; }
+
+		inline ImageData const&			GetImage(int index) const			{ return images_[index]; }
+
+		inline ComPtr<ID2D1Bitmap> const&	GetBitmap(int index) const		{ return bitmaps_[index]; }
+
+		inline GeometryData const&		GetGeometry(int index) const		{ return geometries_[index]; }
+
+		inline ComPtr<IDWriteTextLayout> const&	GetTextLayout(int index) const	{ return text_layouts_[index]; }
+
+	private:
+		void AddCommand(
+			CommandType type,
+			int index
+		);
+
+		// дǰҪı任Ͳ͸
+		void CommitState();
+
+	private:
+		Matrix	transform_;
+		Matrix	committed_transform_;
+		float	opacity_;
+		float	committed_opacity_;
+		bool	transform_committed_;
+		bool	opacity_committed_;
+
+		Array<Command>						commands_;
+		Array<Matrix>						transforms_;
+		Array<float>						opacities_;
+		Array<TextStyleData>				text_styles_;
+		Array<bool>							antialias_modes_;
+		Array<TextAntialias>				text_antialias_modes_;
+		Array<ClipData>						clips_;
+		Array<LayerData>					layers_;
+		Array<ComPtr<ID2D1Bitmap1>>			targets_;
+		Array<ImageData>					images_;
+		Array<ComPtr<ID2D1Bitmap>>			bitmaps_;
+		Array<GeometryData>					geometries_;
+		Array<ComPtr<IDWriteTextLayout>>	text_layouts_;
+	};
+}
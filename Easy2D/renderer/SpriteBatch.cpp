@@ -0,0 +1,73 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SpriteBatch.h"
+
+namespace easy2d
+{
+	namespace
+	{
+		// only translation and positive scaling keep a rect axis-aligned and unflipped
+		inline bool IsAxisAligned(Matrix const& m)
+		{
+			return m._12 == 0.f && m._21 == 0.f && m._11 > 0.f && m._22 > 0.f;
+		}
+	}
+
+	SpriteBatch::SpriteBatch()
+		: bitmap_(nullptr)
+	{
+	}
+
+	bool SpriteBatch::Accepts(void const* bitmap) const
+	{
+		return quads_.empty() || bitmap_ == bitmap;
+	}
+
+	void SpriteBatch::Add(void const* bitmap, Rect const& dest, Rect const& src, Matrix const& transform, float opacity)
+	{
+		E2D_ASSERT(Accepts(bitmap) && "Flush the sprite batch before switching bitmaps");
+
+		bitmap_ = bitmap;
+
+		Quad quad;
+		quad.src = src;
+		quad.opacity = opacity;
+		quad.axis_aligned = IsAxisAligned(transform);
+		if (quad.axis_aligned)
+		{
+			// pre-transform so that consecutive quads share the identity transform
+			quad.dest = transform.Transform(dest);
+		}
+		else
+		{
+			quad.dest = dest;
+			quad.transform = transform;
+		}
+		quads_.push_back(quad);
+	}
+
+	void SpriteBatch::Clear()
+	{
+		// keep the capacity, batches are rebuilt every frame
+		bitmap_ = nullptr;
+		quads_.resize(0);
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2016-2018 Easy2D - Nomango
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include "../macros.h"
+#include "../common/Array.h"
+#include "../math/helper.h"
+
+namespace easy2d
+{
+	// 
+	// ռʹͬһλͼͼƬ, Ⱦλͼ״̬ıʱһύ
+	//  Direct2D, ޴ģʽµʹ
+	class E2D_API SpriteBatch
+	{
+	public:
+		struct Quad
+		{
+			Rect	dest;			// Ŀ
+			Rect	src;			// λͼü
+			Matrix	transform;		// ά任
+			float	opacity;		// ͸
+			bool	axis_aligned;	// Ŀѱ任Ļ, transform Ϊλ
+		};
+
+		SpriteBatch();
+
+		// жλͼǷԼ뵱ǰ
+		bool Accepts(
+			void const* bitmap
+		) const;
+
+		// ͼƬ, λͼ뵱ǰβͬʱҪύ
+		void Add(
+			void const* bitmap,
+			Rect const& dest,
+			Rect const& src,
+			Matrix const& transform,
+			float opacity
+		);
+
+		// 
+		void Clear();
+
+		inline bool					IsEmpty() const		{ return quads_.empty(); }
+
+		inline int					GetCount() const	{ return static_cast<int>(quads_.size()); }
+
+		inline void const*			GetBitmap() const	{ return bitmap_; }
+
+		inline Array<Quad> const&	GetQuads() const	{ return quads_; }
+
+	private:
+		void const*	bitmap_;
+		Array<Quad>	quads_;
+	};
+}
@@ -21,20 +21,63 @@
 #include "render.h"
 #include "../2d/Image.h"
 #include "../base/logs.h"
+#include "../base/FrameProfiler.h"
 #include "../platform/Application.h"
 
 namespace easy2d
 {
+	namespace
+	{
+		Rect IntersectRect(Rect const& a, Rect const& b)
+		{
+			float left = std::max(a.GetLeft(), b.GetLeft());
+			float top = std::max(a.GetTop(), b.GetTop());
+			float right = std::min(a.GetRight(), b.GetRight());
+			float bottom = std::min(a.GetBottom(), b.GetBottom());
+			return Rect{ left, top, std::max(right - left, 0.f), std::max(bottom - top, 0.f) };
+		}
+
+		bool IsSameTextStyle(RenderCommandList::TextStyleData const& a, RenderCommandList::TextStyleData const& b)
+		{
+			return a.color == b.color &&
+				a.has_outline == b.has_outline &&
+				a.outline_color == b.outline_color &&
+				a.outline_width == b.outline_width &&
+				a.outline_stroke == b.outline_stroke;
+		}
+	}
+
 	Renderer::Renderer()
 		: hwnd_(nullptr)
 		, antialias_(true)
 		, vsync_(true)
 		, text_antialias_(TextAntialias::ClearType)
+		, device_text_antialias_(TextAntialias::ClearType)
 		, clear_color_(Color::Black)
 		, opacity_(1.f)
 		, collecting_data_(false)
+		, culling_(true)
+		, headless_(false)
+		, software_(false)
+		, transform_dirty_(true)
+		, sorting_(true)
+		, brush_opacity_(1.f)
+		, layer_depth_(0)
+		, transform_cached_(false)
+		, brush_color_cached_(false)
+		, brush_opacity_cached_(false)
+		, text_style_cached_(false)
+		, antialias_cached_(false)
+		, text_antialias_cached_(false)
+		, device_antialias_(true)
 	{
 		status_.primitives = 0;
+		status_.batches = 0;
+		status_.commands = 0;
+		status_.state_changes = 0;
+		status_.skipped_state_changes = 0;
+		status_.rendered_nodes = 0;
+		status_.culled_nodes = 0;
 	}
 
 	Renderer::~Renderer()
@@ -47,6 +90,48 @@ namespace easy2d
 
 		HRESULT hr;
 
+		if (headless_)
+		{
+			// factories only, geometries and text layouts can still be created
+			hwnd_ = nullptr;
+			device_resources_ = nullptr;
+			hr = DeviceResources::Create(
+				&device_resources_,
+				nullptr
+			);
+
+			if (SUCCEEDED(hr))
+			{
+				factory_ = device_resources_->GetD2DFactory();
+			}
+
+			if (SUCCEEDED(hr) && software_)
+			{
+				hr = device_resources_->CreateSoftwareTarget(
+					static_cast<UINT>(output_size_.x),
+					static_cast<UINT>(output_size_.y)
+				);
+			}
+
+			if (SUCCEEDED(hr) && software_)
+			{
+				device_context_ = device_resources_->GetD2DDeviceContext();
+
+				drawing_state_block_ = nullptr;
+				hr = factory_->CreateDrawingStateBlock(
+					&drawing_state_block_
+				);
+			}
+
+			if (SUCCEEDED(hr) && software_)
+			{
+				hr = CreateDeviceResources();
+			}
+
+			ThrowIfFailed(hr);
+			return;
+		}
+
 		hwnd_ = app->GetWindow()->GetHandle();
 		hr = hwnd_ ? S_OK : E_FAIL;
 		
@@ -90,6 +175,9 @@ namespace easy2d
 	{
 		E2D_LOG(L"Destroying device resources");
 
+		commands_.Clear();
+		sprite_batch_.Clear();
+		batch_bitmap_.Reset();
 		drawing_state_block_.Reset();
 		text_renderer_.Reset();
 		solid_color_brush_.Reset();
@@ -117,8 +205,7 @@ namespace easy2d
 
 		if (SUCCEEDED(hr))
 		{
-			SetAntialiasMode(antialias_);
-			SetTextAntialiasMode(text_antialias_);
+			InvalidateStateCache();
 		}
 		return hr;
 	}
@@ -136,32 +223,99 @@ namespace easy2d
 
 	HRESULT Renderer::BeginDraw()
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
 		if (collecting_data_)
 		{
 			status_.start = time::Now();
 			status_.primitives = 0;
+			status_.batches = 0;
+			status_.commands = 0;
+			status_.state_changes = 0;
+			status_.skipped_state_changes = 0;
+			status_.rendered_nodes = 0;
+			status_.culled_nodes = 0;
 		}
 
+		// antialiased edges may bleed one pixel out of the bounds
+		visible_area_ = Rect{ -1.f, -1.f, output_size_.x + 2.f, output_size_.y + 2.f };
+		clip_areas_.clear();
+		target_areas_.clear();
+		layer_depth_ = 0;
+
+		commands_.Clear();
+		sprite_batch_.Clear();
+		batch_bitmap_.Reset();
+		transform_dirty_ = true;
+		transform_cached_ = false;
+
+		// the modes carry over between frames, the state block restores the device every EndDraw
+		commands_.SetAntialiasMode(antialias_);
+		commands_.SetTextAntialiasMode(text_antialias_);
+
+		if (!device_context_)
+			return S_OK;
+
 		device_context_->SaveDrawingState(drawing_state_block_.Get());
 
 		device_context_->BeginDraw();
+
+		// the software target has no swap chain to clear it
+		if (headless_)
+			device_context_->Clear(DX::ConvertToColorF(clear_color_));
 		return S_OK;
 	}
 
 	HRESULT Renderer::EndDraw()
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		HRESULT hr = device_context_->EndDraw();
+		auto& profiler = FrameProfiler::Instance();
+		profiler.BeginPhase(FramePhase::Submit);
 
-		device_context_->RestoreDrawingState(drawing_state_block_.Get());
+		if (sorting_)
+			commands_.SortImages();
+
+		HRESULT hr = Execute(commands_);
+
+		// a failed frame may stop inside an offscreen target
+		if (!saved_targets_.empty())
+		{
+			device_context_->SetTarget(saved_targets_.front().Get());
+			saved_targets_.clear();
+		}
+
+		// release the resources referenced by this frame
+		commands_.Clear();
+
+		if (!device_context_)
+		{
+			profiler.EndPhase(FramePhase::Submit);
+
+			if (collecting_data_)
+				status_.duration = time::Now() - status_.start;
+			return hr;
+		}
 
+		HRESULT end_hr = device_context_->EndDraw();
 		if (SUCCEEDED(hr))
+			hr = end_hr;
+
+		profiler.EndPhase(FramePhase::Submit);
+
+		device_context_->RestoreDrawingState(drawing_state_block_.Get());
+
+		// the restored block resets transform and antialias modes
+		transform_cached_ = false;
+		antialias_cached_ = false;
+		text_antialias_cached_ = false;
+
+		if (SUCCEEDED(hr) && !headless_)
 		{
+			profiler.BeginPhase(FramePhase::Present);
+
 			// The first argument instructs DXGI to block until VSync.
 			hr = device_resources_->GetDXGISwapChain()->Present(vsync_ ? 1 : 0, 0);
 
@@ -176,6 +330,8 @@ namespace easy2d
 				main_rt_view,
 				reinterpret_cast<float*>(&clear_color_)
 			);
+
+			profiler.EndPhase(FramePhase::Present);
 		}
 
 		if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
@@ -193,6 +349,12 @@ namespace easy2d
 
 	HRESULT Renderer::CreateLayer(ComPtr<ID2D1Layer>& layer)
 	{
+		if (!device_context_ && headless_)
+		{
+			layer = nullptr;
+			return S_OK;
+		}
+
 		if (!device_context_)
 			return E_UNEXPECTED;
 
@@ -207,64 +369,171 @@ namespace easy2d
 		StrokeStyle stroke
 	)
 	{
-		if (!solid_color_brush_ || !device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		solid_color_brush_->SetColor(DX::ConvertToColorF(stroke_color));
-
-		device_context_->DrawGeometry(
-			geometry.Get(),
-			solid_color_brush_.Get(),
-			stroke_width,
-			device_resources_->GetStrokeStyle(stroke)
-		);
-
-		if (collecting_data_)
-			++status_.primitives;
+		commands_.DrawGeometry(geometry, stroke_color, stroke_width, stroke);
 		return S_OK;
 	}
 
 	HRESULT Renderer::FillGeometry(ComPtr<ID2D1Geometry> const & geometry, Color const& fill_color)
 	{
-		if (!solid_color_brush_ || !device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		solid_color_brush_->SetColor(DX::ConvertToColorF(fill_color));
-		device_context_->FillGeometry(
-			geometry.Get(),
-			solid_color_brush_.Get()
-		);
-
+		commands_.FillGeometry(geometry, fill_color);
 		return S_OK;
 	}
 
 	HRESULT Renderer::DrawImage(ImagePtr const & image, Rect const& dest_rect)
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		if (!image->GetBitmap())
+		ComPtr<ID2D1Bitmap> const& bitmap = image->GetBitmap();
+		if (!bitmap && !headless_)
 			return S_OK;
 
-		device_context_->DrawBitmap(
-			image->GetBitmap().Get(),
-			DX::ConvertToRectF(dest_rect),
-			opacity_,
-			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
-			DX::ConvertToRectF(image->GetCropRect())
-		);
+		// images without a bitmap are batched by themselves in headless mode
+		void const* key = bitmap
+			? static_cast<void const*>(bitmap.Get())
+			: static_cast<void const*>(image.Get());
 
-		if (collecting_data_)
-			++status_.primitives;
+		commands_.DrawImage(bitmap, key, dest_rect, image->GetCropRect());
 		return S_OK;
 	}
 
 	HRESULT Renderer::DrawBitmap(ComPtr<ID2D1Bitmap> const & bitmap)
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		if (!bitmap && !headless_)
+			return S_OK;
+
+		commands_.DrawBitmap(bitmap);
+		return S_OK;
+	}
+
+	HRESULT Renderer::DrawTextLayout(ComPtr<IDWriteTextLayout> const& text_layout)
+	{
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		if (!bitmap)
+		commands_.DrawTextLayout(text_layout);
+		return S_OK;
+	}
+
+	HRESULT Renderer::Execute(RenderCommandList const& list)
+	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		typedef RenderCommandList::CommandType CommandType;
+
+		HRESULT hr = S_OK;
+		const int count = list.GetCount();
+		for (int i = 0; i < count && SUCCEEDED(hr); ++i)
+		{
+			RenderCommandList::Command const& command = list.GetCommand(i);
+			switch (command.type)
+			{
+			case CommandType::Transform:
+				transform_ = list.GetTransform(command.index);
+				transform_dirty_ = true;
+				break;
+			case CommandType::Opacity:
+				opacity_ = list.GetOpacity(command.index);
+				ApplyBrushOpacity(opacity_);
+				break;
+			case CommandType::TextStyle:
+				hr = ExecuteTextStyle(list.GetTextStyle(command.index));
+				break;
+			case CommandType::Antialias:
+				hr = ExecuteAntialiasMode(list.GetAntialiasMode(command.index));
+				break;
+			case CommandType::TextAntialias:
+				hr = ExecuteTextAntialiasMode(list.GetTextAntialiasMode(command.index));
+				break;
+			case CommandType::PushClip:
+				hr = ExecutePushClip(list.GetClip(command.index));
+				break;
+			case CommandType::PopClip:
+				hr = ExecutePopClip();
+				break;
+			case CommandType::PushLayer:
+				hr = ExecutePushLayer(list.GetLayer(command.index));
+				break;
+			case CommandType::PopLayer:
+				hr = ExecutePopLayer();
+				break;
+			case CommandType::PushTarget:
+				hr = ExecutePushTarget(list.GetTarget(command.index));
+				break;
+			case CommandType::PopTarget:
+				hr = ExecutePopTarget();
+				break;
+			case CommandType::Image:
+				hr = ExecuteImage(list.GetImage(command.index));
+				break;
+			case CommandType::Bitmap:
+				hr = ExecuteBitmap(list.GetBitmap(command.index));
+				break;
+			case CommandType::Geometry:
+				hr = ExecuteGeometry(list.GetGeometry(command.index), false);
+				break;
+			case CommandType::FillGeometry:
+				hr = ExecuteGeometry(list.GetGeometry(command.index), true);
+				break;
+			case CommandType::Text:
+				hr = ExecuteText(list.GetTextLayout(command.index));
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			hr = FlushSprites();
+		}
+
+		if (collecting_data_)
+			status_.commands += count;
+		return hr;
+	}
+
+	HRESULT Renderer::ExecuteImage(RenderCommandList::ImageData const& image)
+	{
+		HRESULT hr = S_OK;
+		if (!sprite_batch_.Accepts(image.key))
+		{
+			hr = FlushSprites();
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			if (sprite_batch_.IsEmpty())
+				batch_bitmap_ = image.bitmap;
+
+			sprite_batch_.Add(image.key, image.dest, image.src, image.transform, image.opacity);
+
+			if (collecting_data_)
+				++status_.primitives;
+		}
+		return hr;
+	}
+
+	HRESULT Renderer::ExecuteBitmap(ComPtr<ID2D1Bitmap> const& bitmap)
+	{
+		HRESULT hr = Flush();
+		if (FAILED(hr))
+			return hr;
+
+		if (collecting_data_)
+			++status_.primitives;
+
+		if (!device_context_ || !bitmap)
 			return S_OK;
 
 		// Do not crop bitmap 
@@ -276,75 +545,473 @@ namespace easy2d
 			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
 			rect
 		);
+		return S_OK;
+	}
+
+	HRESULT Renderer::ExecuteGeometry(RenderCommandList::GeometryData const& geometry, bool fill)
+	{
+		HRESULT hr = Flush();
+		if (FAILED(hr))
+			return hr;
 
 		if (collecting_data_)
-		++status_.primitives;
+			++status_.primitives;
+
+		if (!device_context_)
+			return S_OK;
+
+		if (!solid_color_brush_)
+			return E_UNEXPECTED;
+
+		ApplyBrushColor(geometry.color);
+
+		if (fill)
+		{
+			device_context_->FillGeometry(
+				geometry.geometry.Get(),
+				solid_color_brush_.Get()
+			);
+		}
+		else
+		{
+			device_context_->DrawGeometry(
+				geometry.geometry.Get(),
+				solid_color_brush_.Get(),
+				geometry.stroke_width,
+				device_resources_->GetStrokeStyle(geometry.stroke)
+			);
+		}
 		return S_OK;
 	}
 
-	HRESULT Renderer::DrawTextLayout(ComPtr<IDWriteTextLayout> const& text_layout)
+	HRESULT Renderer::ExecuteText(ComPtr<IDWriteTextLayout> const& text_layout)
 	{
-		if (!text_renderer_)
-			return E_UNEXPECTED;
+		HRESULT hr = Flush();
+		if (FAILED(hr))
+			return hr;
 
 		if (collecting_data_)
 			++status_.primitives;
+
+		if (!device_context_)
+			return S_OK;
+
+		if (!text_renderer_)
+			return E_UNEXPECTED;
+
 		return text_layout->Draw(nullptr, text_renderer_.Get(), 0, 0);
 	}
 
-	void Renderer::SetVSyncEnabled(bool enabled)
+	HRESULT Renderer::ExecuteTextStyle(RenderCommandList::TextStyleData const& style)
 	{
-		vsync_ = enabled;
+		if (!device_context_)
+			return S_OK;
+
+		if (!text_renderer_ || !device_resources_)
+			return E_UNEXPECTED;
+
+		if (text_style_cached_ && IsSameTextStyle(text_style_, style))
+		{
+			IncreaseStateChanges(true);
+			return S_OK;
+		}
+
+		text_style_ = style;
+		text_style_cached_ = true;
+		IncreaseStateChanges(false);
+
+		text_renderer_->SetTextStyle(
+			DX::ConvertToColorF(style.color),
+			style.has_outline,
+			DX::ConvertToColorF(style.outline_color),
+			style.outline_width,
+			device_resources_->GetStrokeStyle(style.outline_stroke)
+		);
+		return S_OK;
 	}
 
-	HRESULT Renderer::PushClip(const Matrix & clip_matrix, const Size & clip_size)
+	HRESULT Renderer::ExecutePushClip(RenderCommandList::ClipData const& clip)
 	{
-		if (!device_context_)
-			return E_UNEXPECTED;
+		HRESULT hr = FlushSprites();
+		if (FAILED(hr) || !device_context_)
+			return hr;
 
-		device_context_->SetTransform(DX::ConvertToMatrix3x2F(clip_matrix));
+		transform_dirty_ = true;
+		ApplyTransform(clip.matrix);
 		device_context_->PushAxisAlignedClip(
-			D2D1::RectF(0, 0, clip_size.x, clip_size.y),
+			D2D1::RectF(0, 0, clip.size.x, clip.size.y),
 			D2D1_ANTIALIAS_MODE_PER_PRIMITIVE
 		);
 		return S_OK;
 	}
 
-	HRESULT Renderer::PopClip()
+	HRESULT Renderer::ExecutePopClip()
 	{
-		if (!device_context_)
-			return E_UNEXPECTED;
+		HRESULT hr = FlushSprites();
+		if (FAILED(hr) || !device_context_)
+			return hr;
 
 		device_context_->PopAxisAlignedClip();
 		return S_OK;
 	}
 
-	HRESULT Renderer::PushLayer(ComPtr<ID2D1Layer> const& layer, LayerProperties const& properties)
+	HRESULT Renderer::ExecutePushLayer(RenderCommandList::LayerData const& layer)
 	{
-		if (!device_context_ || !solid_color_brush_)
+		HRESULT hr = Flush();
+		if (FAILED(hr) || !device_context_)
+			return hr;
+
+		if (!solid_color_brush_)
 			return E_UNEXPECTED;
 
 		device_context_->PushLayer(
 			D2D1::LayerParameters(
-				DX::ConvertToRectF(properties.area),
+				DX::ConvertToRectF(layer.properties.area),
 				nullptr,
 				D2D1_ANTIALIAS_MODE_PER_PRIMITIVE,
 				D2D1::Matrix3x2F::Identity(),
-				properties.opacity,
+				layer.properties.opacity,
 				solid_color_brush_.Get(),
 				D2D1_LAYER_OPTIONS_NONE
 			),
-			layer.Get()
+			layer.layer.Get()
 		);
 		return S_OK;
 	}
 
+	HRESULT Renderer::ExecutePopLayer()
+	{
+		HRESULT hr = FlushSprites();
+		if (FAILED(hr) || !device_context_)
+			return hr;
+
+		device_context_->PopLayer();
+		return S_OK;
+	}
+
+	HRESULT Renderer::ExecutePushTarget(ComPtr<ID2D1Bitmap1> const& target)
+	{
+		HRESULT hr = FlushSprites();
+		if (FAILED(hr) || !device_context_)
+			return hr;
+
+		ComPtr<ID2D1Image> current;
+		device_context_->GetTarget(&current);
+		saved_targets_.push_back(current);
+
+		device_context_->SetTarget(target.Get());
+		device_context_->Clear(D2D1::ColorF(0.f, 0.f, 0.f, 0.f));
+		return S_OK;
+	}
+
+	HRESULT Renderer::ExecutePopTarget()
+	{
+		HRESULT hr = FlushSprites();
+		if (FAILED(hr) || !device_context_)
+			return hr;
+
+		if (saved_targets_.empty())
+			return E_UNEXPECTED;
+
+		device_context_->SetTarget(saved_targets_.back().Get());
+		saved_targets_.pop_back();
+		return S_OK;
+	}
+
+	HRESULT Renderer::FlushSprites()
+	{
+		if (sprite_batch_.IsEmpty())
+			return S_OK;
+
+		if (collecting_data_)
+			++status_.batches;
+
+		if (device_context_)
+		{
+			// ID2D1SpriteBatch needs the Windows 10 SDK, so the batch is submitted
+			// as consecutive DrawBitmap calls that only switch transform when needed
+			bool identity = false;
+			for (const auto& quad : sprite_batch_.GetQuads())
+			{
+				if (quad.axis_aligned)
+				{
+					if (!identity)
+					{
+						ApplyTransform(Matrix{});
+						identity = true;
+					}
+				}
+				else
+				{
+					ApplyTransform(quad.transform);
+					identity = false;
+				}
+
+				device_context_->DrawBitmap(
+					batch_bitmap_.Get(),
+					DX::ConvertToRectF(quad.dest),
+					quad.opacity,
+					D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
+					DX::ConvertToRectF(quad.src)
+				);
+			}
+			transform_dirty_ = true;
+		}
+
+		sprite_batch_.Clear();
+		batch_bitmap_.Reset();
+		return S_OK;
+	}
+
+	HRESULT Renderer::Flush()
+	{
+		HRESULT hr = FlushSprites();
+
+		if (SUCCEEDED(hr) && transform_dirty_ && device_context_)
+		{
+			ApplyTransform(transform_);
+			transform_dirty_ = false;
+		}
+		return hr;
+	}
+
+	void Renderer::ApplyTransform(Matrix const& matrix)
+	{
+		if (transform_cached_ && device_transform_ == matrix)
+		{
+			IncreaseStateChanges(true);
+			return;
+		}
+
+		device_context_->SetTransform(DX::ConvertToMatrix3x2F(matrix));
+		device_transform_ = matrix;
+		transform_cached_ = true;
+		IncreaseStateChanges(false);
+	}
+
+	void Renderer::ApplyBrushColor(Color const& color)
+	{
+		if (brush_color_cached_ && brush_color_ == color)
+		{
+			IncreaseStateChanges(true);
+			return;
+		}
+
+		solid_color_brush_->SetColor(DX::ConvertToColorF(color));
+		brush_color_ = color;
+		brush_color_cached_ = true;
+		IncreaseStateChanges(false);
+	}
+
+	void Renderer::ApplyBrushOpacity(float opacity)
+	{
+		if (!solid_color_brush_)
+			return;
+
+		if (brush_opacity_cached_ && brush_opacity_ == opacity)
+		{
+			IncreaseStateChanges(true);
+			return;
+		}
+
+		solid_color_brush_->SetOpacity(opacity);
+		brush_opacity_ = opacity;
+		brush_opacity_cached_ = true;
+		IncreaseStateChanges(false);
+	}
+
+	void Renderer::InvalidateStateCache()
+	{
+		transform_cached_ = false;
+		brush_color_cached_ = false;
+		brush_opacity_cached_ = false;
+		text_style_cached_ = false;
+		antialias_cached_ = false;
+		text_antialias_cached_ = false;
+	}
+
+	void Renderer::IncreaseStateChanges(bool skipped)
+	{
+		if (collecting_data_)
+		{
+			if (skipped)
+				++status_.skipped_state_changes;
+			else
+				++status_.state_changes;
+		}
+	}
+
+	void Renderer::SetVSyncEnabled(bool enabled)
+	{
+		vsync_ = enabled;
+	}
+
+	void Renderer::SetHeadlessMode(bool enabled)
+	{
+		E2D_ASSERT(!device_resources_ && "Headless mode must be set before the renderer is set up");
+
+		headless_ = enabled;
+	}
+
+	void Renderer::SetSoftwareRendering(bool enabled)
+	{
+		E2D_ASSERT(!device_resources_ && "Software rendering must be set before the renderer is set up");
+
+		software_ = enabled;
+	}
+
+	HRESULT Renderer::ReadPixels(PixelBuffer& buffer)
+	{
+		IWICBitmap* target = device_resources_ ? device_resources_->GetWICTargetBitmap() : nullptr;
+		if (!target)
+			return E_UNEXPECTED;
+
+		UINT width = 0;
+		UINT height = 0;
+		HRESULT hr = target->GetSize(&width, &height);
+
+		ComPtr<IWICBitmapLock> lock;
+		if (SUCCEEDED(hr))
+		{
+			WICRect rect = { 0, 0, static_cast<INT>(width), static_cast<INT>(height) };
+			hr = target->Lock(&rect, WICBitmapLockRead, &lock);
+		}
+
+		UINT stride = 0;
+		if (SUCCEEDED(hr))
+		{
+			hr = lock->GetStride(&stride);
+		}
+
+		UINT size = 0;
+		BYTE* data = nullptr;
+		if (SUCCEEDED(hr))
+		{
+			hr = lock->GetDataPointer(&size, &data);
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			buffer.Resize(static_cast<int>(width), static_cast<int>(height));
+			buffer.CopyFromBGRA(data, static_cast<int>(stride));
+		}
+		return hr;
+	}
+
+	void Renderer::SetCullingEnabled(bool enabled)
+	{
+		culling_ = enabled;
+	}
+
+	HRESULT Renderer::PushClip(const Matrix & clip_matrix, const Size & clip_size)
+	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		// transforms are recorded relative to the current offscreen target
+		if (!target_areas_.empty())
+			commands_.PushClip(clip_matrix * Matrix::Translation(-target_areas_.back().area.origin), clip_size);
+		else
+			commands_.PushClip(clip_matrix, clip_size);
+
+		clip_areas_.push_back(visible_area_);
+		visible_area_ = IntersectRect(visible_area_, clip_matrix.Transform(Rect{ Point{}, clip_size }));
+		return S_OK;
+	}
+
+	HRESULT Renderer::PopClip()
+	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		commands_.PopClip();
+
+		if (!clip_areas_.empty())
+		{
+			visible_area_ = clip_areas_.back();
+			clip_areas_.pop_back();
+		}
+		return S_OK;
+	}
+
+	HRESULT Renderer::PushLayer(ComPtr<ID2D1Layer> const& layer, LayerProperties const& properties)
+	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		commands_.PushLayer(layer, properties);
+		++layer_depth_;
+		return S_OK;
+	}
+
 	HRESULT Renderer::PopLayer()
 	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		commands_.PopLayer();
+		if (layer_depth_ > 0)
+			--layer_depth_;
+		return S_OK;
+	}
+
+	HRESULT Renderer::CreateTargetBitmap(ComPtr<ID2D1Bitmap1>& bitmap, Size const& size)
+	{
+		bitmap = nullptr;
+
+		if (!device_context_ && headless_)
+			return S_OK;
+
 		if (!device_context_)
 			return E_UNEXPECTED;
 
-		device_context_->PopLayer();
+		return device_context_->CreateBitmap(
+			D2D1::SizeU(
+				static_cast<UINT32>(std::ceil(size.x)),
+				static_cast<UINT32>(std::ceil(size.y))
+			),
+			nullptr,
+			0,
+			D2D1::BitmapProperties1(
+				D2D1_BITMAP_OPTIONS_TARGET,
+				D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
+			),
+			&bitmap
+		);
+	}
+
+	HRESULT Renderer::PushTarget(ComPtr<ID2D1Bitmap1> const& target, Rect const& area)
+	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		// Direct2D can't switch targets while clips or layers are pushed
+		if (!target || !clip_areas_.empty() || layer_depth_ > 0)
+			return S_FALSE;
+
+		commands_.PushTarget(target);
+
+		TargetArea target_area;
+		target_area.area = area;
+		target_area.visible_area = visible_area_;
+		target_areas_.push_back(target_area);
+
+		visible_area_ = IntersectRect(visible_area_, area);
+		return S_OK;
+	}
+
+	HRESULT Renderer::PopTarget()
+	{
+		if (!device_context_ && !headless_)
+			return E_UNEXPECTED;
+
+		if (target_areas_.empty())
+			return E_UNEXPECTED;
+
+		commands_.PopTarget();
+
+		visible_area_ = target_areas_.back().visible_area;
+		target_areas_.pop_back();
 		return S_OK;
 	}
 
@@ -352,13 +1019,39 @@ namespace easy2d
 	{
 		output_size_.x = static_cast<float>(width);
 		output_size_.y = static_cast<float>(height);
-		if (device_resources_)
+		if (device_resources_ && !headless_)
 		{
 			return device_resources_->SetLogicalSize(output_size_);
 		}
 		return S_OK;
 	}
 
+	bool Renderer::CheckVisibility(Rect const& bounds)
+	{
+		if (IsInVisibleArea(bounds))
+			return true;
+
+		IncreaseCulledNodes();
+		return false;
+	}
+
+	bool Renderer::IsInVisibleArea(Rect const& bounds) const
+	{
+		return !culling_ || bounds.Intersects(visible_area_);
+	}
+
+	void Renderer::IncreaseRenderedNodes()
+	{
+		if (collecting_data_)
+			++status_.rendered_nodes;
+	}
+
+	void Renderer::IncreaseCulledNodes()
+	{
+		if (collecting_data_)
+			++status_.culled_nodes;
+	}
+
 	void Renderer::StartCollectData()
 	{
 		collecting_data_ = true;
@@ -376,20 +1069,24 @@ namespace easy2d
 
 	HRESULT Renderer::SetTransform(const Matrix & matrix)
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		device_context_->SetTransform(DX::ConvertToMatrix3x2F(matrix));
+		if (!target_areas_.empty())
+			commands_.SetTransform(matrix * Matrix::Translation(-target_areas_.back().area.origin));
+		else
+			commands_.SetTransform(matrix);
 		return S_OK;
 	}
 
 	void Renderer::SetOpacity(float opacity)
 	{
-		if (opacity_ != opacity)
-		{
-			opacity_ = opacity;
-			solid_color_brush_->SetOpacity(opacity);
-		}
+		commands_.SetOpacity(opacity);
+	}
+
+	void Renderer::SetCommandSortingEnabled(bool enabled)
+	{
+		sorting_ = enabled;
 	}
 
 	HRESULT Renderer::SetTextStyle(
@@ -400,39 +1097,80 @@ namespace easy2d
 		StrokeStyle outline_stroke
 	)
 	{
-		if (!text_renderer_ || !device_resources_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		text_renderer_->SetTextStyle(
-			DX::ConvertToColorF(color),
-			has_outline,
-			DX::ConvertToColorF(outline_color),
-			outline_width,
-			device_resources_->GetStrokeStyle(outline_stroke)
-		);
+		RenderCommandList::TextStyleData style;
+		style.color = color;
+		style.has_outline = has_outline;
+		style.outline_color = outline_color;
+		style.outline_width = outline_width;
+		style.outline_stroke = outline_stroke;
+		commands_.SetTextStyle(style);
 		return S_OK;
 	}
 
 	HRESULT Renderer::SetAntialiasMode(bool enabled)
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
-		device_context_->SetAntialiasMode(
-			enabled ? D2D1_ANTIALIAS_MODE_PER_PRIMITIVE : D2D1_ANTIALIAS_MODE_ALIASED
-		);
 		antialias_ = enabled;
+		commands_.SetAntialiasMode(enabled);
 		return S_OK;
 	}
 
 	HRESULT Renderer::SetTextAntialiasMode(TextAntialias mode)
 	{
-		if (!device_context_)
+		if (!device_context_ && !headless_)
 			return E_UNEXPECTED;
 
 		text_antialias_ = mode;
+		commands_.SetTextAntialiasMode(mode);
+		return S_OK;
+	}
+
+	HRESULT Renderer::ExecuteAntialiasMode(bool enabled)
+	{
+		if (!device_context_)
+			return S_OK;
+
+		if (antialias_cached_ && device_antialias_ == enabled)
+		{
+			IncreaseStateChanges(true);
+			return S_OK;
+		}
+
+		// sprites recorded before the change are drawn with the old mode
+		HRESULT hr = FlushSprites();
+		if (FAILED(hr))
+			return hr;
+
+		device_context_->SetAntialiasMode(
+			enabled ? D2D1_ANTIALIAS_MODE_PER_PRIMITIVE : D2D1_ANTIALIAS_MODE_ALIASED
+		);
+		device_antialias_ = enabled;
+		antialias_cached_ = true;
+		IncreaseStateChanges(false);
+		return S_OK;
+	}
+
+	HRESULT Renderer::ExecuteTextAntialiasMode(TextAntialias mode)
+	{
+		if (!device_context_)
+			return S_OK;
+
+		if (text_antialias_cached_ && device_text_antialias_ == mode)
+		{
+			IncreaseStateChanges(true);
+			return S_OK;
+		}
+
+		device_text_antialias_ = mode;
+		text_antialias_cached_ = true;
+		IncreaseStateChanges(false);
 		D2D1_TEXT_ANTIALIAS_MODE antialias_mode = D2D1_TEXT_ANTIALIAS_MODE_CLEARTYPE;
-		switch (text_antialias_)
+		switch (mode)
 		{
 		case TextAntialias::Default:
 			antialias_mode = D2D1_TEXT_ANTIALIAS_MODE_DEFAULT;
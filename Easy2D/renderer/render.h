@@ -28,6 +28,9 @@
 #include "helper.hpp"
 #include "DeviceResources.h"
 #include "TextRenderer.h"
+#include "SpriteBatch.h"
+#include "RenderCommandList.h"
+#include "PixelBuffer.h"
 
 namespace easy2d
 {
@@ -36,6 +39,12 @@ namespace easy2d
 		TimePoint start;
 		Duration duration;
 		int primitives;
+		int batches;
+		int commands;
+		int state_changes;			// ύ豸״̬ı
+		int skipped_state_changes;	// 豸ǰ״̬ͬ״̬ı
+		int rendered_nodes;
+		int culled_nodes;
 	};
 
 	class E2D_API Renderer
@@ -98,6 +107,49 @@ namespace easy2d
 			bool enabled
 		);
 
+		// ر޴ģʽ, Ҫڳʼǰ
+		// ޴ģʽ² Direct3D 豸, лƵֻͳ
+		void SetHeadlessMode(
+			bool enabled
+		);
+
+		// رȾ, Ҫڳʼǰ
+		// ޴ģʽ CPU Ƶڴλͼ, Сڳʼʱȷ, ͨ ReadPixels ȡ
+		void SetSoftwareRendering(
+			bool enabled
+		);
+
+		// ȡȾĽ, Ҫ EndDraw ֮
+		HRESULT ReadPixels(
+			PixelBuffer& buffer
+		);
+
+		// ر, ʹͬһλͼͼƬᾡϲΪһ
+		void SetCommandSortingEnabled(
+			bool enabled
+		);
+
+		// رӿ޳
+		void SetCullingEnabled(
+			bool enabled
+		);
+
+		// жϰΧǷڿɼ, ɼʱ¼ΪüĽڵ
+		bool CheckVisibility(
+			Rect const& bounds
+		);
+
+		// жϰΧǷڿɼ
+		bool IsInVisibleArea(
+			Rect const& bounds
+		) const;
+
+		// ¼ȾĽڵ
+		void IncreaseRenderedNodes();
+
+		// ¼üĽڵ
+		void IncreaseCulledNodes();
+
 		// û͸
 		void SetOpacity(
 			float opacity
@@ -129,6 +181,28 @@ namespace easy2d
 
 		HRESULT PopLayer();
 
+		// ΪĿλͼ
+		// ޴ģʽû豸ʱ, λͼΪ
+		HRESULT CreateTargetBitmap(
+			ComPtr<ID2D1Bitmap1>& bitmap,
+			Size const& size
+		);
+
+		// ʼƵλͼ, area ΪλͼӦĻ
+		// üͼ޷лĿ, ʱ S_FALSE
+		HRESULT PushTarget(
+			ComPtr<ID2D1Bitmap1> const& target,
+			Rect const& area
+		);
+
+		HRESULT PopTarget();
+
+		// ִȾ, Ҫ BeginDraw  EndDraw ֮
+		// Ƶֻ¼ǰ֡б, EndDraw ʱͳһִ
+		HRESULT Execute(
+			RenderCommandList const& list
+		);
+
 		HRESULT Resize(
 			UINT width,
 			UINT height
@@ -149,6 +223,20 @@ namespace easy2d
 
 		inline Size const&				GetOutputSize() const		{ return output_size_; }
 
+		inline Rect const&				GetVisibleArea() const		{ return visible_area_; }
+
+		inline bool						IsCullingEnabled() const	{ return culling_; }
+
+		inline bool						IsHeadless() const			{ return headless_; }
+
+		inline bool						IsVSyncEnabled() const		{ return vsync_; }
+
+		inline bool						IsSoftwareRendering() const	{ return software_; }
+
+		inline bool						IsCommandSortingEnabled() const	{ return sorting_; }
+
+		inline RenderCommandList const&	GetCommandList() const		{ return commands_; }
+
 		inline DeviceResources*			GetDeviceResources() const	{ return device_resources_.Get(); }
 
 		inline ITextRenderer*			GetTextRenderer() const		{ return text_renderer_.Get(); }
@@ -164,7 +252,86 @@ namespace easy2d
 
 		HRESULT HandleDeviceLost();
 
+		HRESULT ExecuteImage(
+			RenderCommandList::ImageData const& image
+		);
+
+		HRESULT ExecuteBitmap(
+			ComPtr<ID2D1Bitmap> const& bitmap
+		);
+
+		HRESULT ExecuteGeometry(
+			RenderCommandList::GeometryData const& geometry,
+			bool fill
+		);
+
+		HRESULT ExecuteText(
+			ComPtr<IDWriteTextLayout> const& text_layout
+		);
+
+		HRESULT ExecuteTextStyle(
+			RenderCommandList::TextStyleData const& style
+		);
+
+		HRESULT ExecuteAntialiasMode(
+			bool enabled
+		);
+
+		HRESULT ExecuteTextAntialiasMode(
+			TextAntialias mode
+		);
+
+		HRESULT ExecutePushClip(
+			RenderCommandList::ClipData const& clip
+		);
+
+		HRESULT ExecutePopClip();
+
+		HRESULT ExecutePushLayer(
+			RenderCommandList::LayerData const& layer
+		);
+
+		HRESULT ExecutePopLayer();
+
+		HRESULT ExecutePushTarget(
+			ComPtr<ID2D1Bitmap1> const& target
+		);
+
+		HRESULT ExecutePopTarget();
+
+		// ύδɵľ
+		HRESULT FlushSprites();
+
+		// ύδɵľβӦõǰ任
+		HRESULT Flush();
+
+		// 豸״̬, 뻺״̬ͬʱ
+		void ApplyTransform(
+			Matrix const& matrix
+		);
+
+		void ApplyBrushColor(
+			Color const& color
+		);
+
+		void ApplyBrushOpacity(
+			float opacity
+		);
+
+		// 豸Դؽ, ״̬ȫʧЧ
+		void InvalidateStateCache();
+
+		void IncreaseStateChanges(
+			bool skipped
+		);
+
 	private:
+		struct TargetArea
+		{
+			Rect area;
+			Rect visible_area;
+		};
+
 		unsigned long ref_count_;
 
 		HWND hwnd_;
@@ -172,11 +339,35 @@ namespace easy2d
 		bool antialias_;
 		bool vsync_;
 		bool collecting_data_;
+		bool culling_;
+		bool headless_;
+		bool software_;
+		bool transform_dirty_;
+		bool sorting_;
+		bool transform_cached_;
+		bool brush_color_cached_;
+		bool brush_opacity_cached_;
+		bool text_style_cached_;
+		bool antialias_cached_;
+		bool text_antialias_cached_;
+		bool device_antialias_;
+		float brush_opacity_;
+		int layer_depth_;
 
 		Size			output_size_;
+		Rect			visible_area_;
+		Array<Rect>		clip_areas_;
+		Array<TargetArea>	target_areas_;
 		Color			clear_color_;
 		TextAntialias	text_antialias_;
+		TextAntialias	device_text_antialias_;
 		RenderStatus	status_;
+		Matrix			transform_;
+		SpriteBatch		sprite_batch_;
+		RenderCommandList	commands_;
+		Matrix			device_transform_;
+		Color			brush_color_;
+		RenderCommandList::TextStyleData	text_style_;
 
 		ComPtr<DeviceResources>			device_resources_;
 		ComPtr<ID2D1Factory1>			factory_;
@@ -184,5 +375,7 @@ namespace easy2d
 		ComPtr<ID2D1DrawingStateBlock>	drawing_state_block_;
 		ComPtr<ITextRenderer>			text_renderer_;
 		ComPtr<ID2D1SolidColorBrush>	solid_color_brush_;
+		ComPtr<ID2D1Bitmap>				batch_bitmap_;
+		Array<ComPtr<ID2D1Image>>		saved_targets_;
 	};
 }
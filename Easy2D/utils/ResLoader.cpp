@@ -22,6 +22,7 @@
 #include "../platform/modules.h"
 #include "../2d/Image.h"
 #include "../2d/Frames.h"
+#include "../base/Trace.h"
 
 namespace easy2d
 {
@@ -46,6 +47,8 @@ namespace easy2d
 
 	bool ResLoader::AddImage(String const& id, Resource const& image)
 	{
+		E2D_PROFILE_SCOPE("ResLoader::AddImage");
+
 		ImagePtr ptr = new (std::nothrow) Image;
 		if (ptr)
 		{
@@ -70,6 +73,8 @@ namespace easy2d
 
 	int ResLoader::AddFrames(String const& id, Array<Resource> const& images)
 	{
+		E2D_PROFILE_SCOPE("ResLoader::AddFrames");
+
 		if (images.empty())
 			return 0;
 
@@ -94,7 +99,7 @@ namespace easy2d
 			if (frames)
 			{
 				res_.insert(std::make_pair(id, frames));
-				return frames->GetFrames().size();
+				return frames->GetFrameCount();
 			}
 		}
 		return 0;
@@ -109,13 +114,15 @@ namespace easy2d
 		if (frames)
 		{
 			res_.insert(std::make_pair(id, frames));
-			return frames->GetFrames().size();
+			return frames->GetFrameCount();
 		}
 		return 0;
 	}
 
 	int ResLoader::AddFrames(String const & id, Resource const & image, int cols, int rows)
 	{
+		E2D_PROFILE_SCOPE("ResLoader::AddFrames");
+
 		if (cols <= 0 || rows <= 0)
 			return 0;
 
@@ -128,55 +135,39 @@ namespace easy2d
 		float width = raw_width / cols;
 		float height = raw_height / rows;
 
-		Array<ImagePtr> image_arr;
-		image_arr.reserve(rows * cols);
+		Array<Rect> crop_rects;
+		crop_rects.reserve(rows * cols);
 
 		for (int i = 0; i < rows; i++)
 		{
 			for (int j = 0; j < cols; j++)
 			{
-				ImagePtr ptr = new (std::nothrow) Image(raw->GetBitmap());
-				if (ptr)
-				{
-					ptr->Crop(Rect{ i * width, j * height, width, height });
-					image_arr.push_back(ptr);
-				}
+				crop_rects.push_back(Rect{ j * width, i * height, width, height });
 			}
 		}
 
-		FramesPtr frames = new (std::nothrow) Frames(image_arr);
+		FramesPtr frames = new (std::nothrow) Frames(raw, crop_rects);
 		if (frames)
 		{
 			res_.insert(std::make_pair(id, frames));
-			return frames->GetFrames().size();
+			return frames->GetFrameCount();
 		}
 		return 0;
 	}
 
 	int ResLoader::AddFrames(String const & id, Resource const & image, Array<Rect> const & crop_rects)
 	{
+		E2D_PROFILE_SCOPE("ResLoader::AddFrames");
+
 		ImagePtr raw = new (std::nothrow) Image;
 		if (!raw || !raw->Load(LocateRes(image, search_paths_)))
 			return 0;
 
-		Array<ImagePtr> image_arr;
-		image_arr.reserve(crop_rects.size());
-
-		for (const auto& rect : crop_rects)
-		{
-			ImagePtr ptr = new (std::nothrow) Image(raw->GetBitmap());
-			if (ptr)
-			{
-				ptr->Crop(rect);
-				image_arr.push_back(ptr);
-			}
-		}
-
-		FramesPtr frames = new (std::nothrow) Frames(image_arr);
+		FramesPtr frames = new (std::nothrow) Frames(raw, crop_rects);
 		if (frames)
 		{
 			res_.insert(std::make_pair(id, frames));
-			return frames->GetFrames().size();
+			return frames->GetFrameCount();
 		}
 		return 0;
 	}
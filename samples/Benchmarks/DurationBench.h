@@ -0,0 +1,123 @@
+// Copyright (C) 2019 Nomango
+
+#pragma once
+#include "common.h"
+#include <regex>
+#include <unordered_map>
+
+// ʱν
+// ԱȾɵĻʽ ParseDuration дĽ
+namespace DurationBench
+{
+	// ɵʵ, ʽУʽ, νȡַõλ
+	inline Duration RegexParseDuration(std::wstring const& str)
+	{
+		static const std::wregex duration_regex(LR"([-+]?([0-9]*(\.[0-9]*)?[a-z]+)+)");
+		static const std::unordered_map<std::wstring, Duration> unit_map =
+		{
+			{ L"ms", time::Millisecond },
+			{ L"s", time::Second },
+			{ L"m", time::Minute },
+			{ L"h", time::Hour },
+		};
+
+		size_t len = str.length();
+		size_t pos = 0;
+		bool negative = false;
+		Duration d;
+
+		if (!std::regex_match(str, duration_regex))
+			return Duration();
+
+		if (str.empty() || str == L"0")
+			return d;
+
+		if (str[0] == L'-' || str[0] == L'+')
+		{
+			negative = (str[0] == L'-');
+			pos++;
+		}
+
+		while (pos < len)
+		{
+			size_t i = pos;
+			for (; i < len; ++i)
+			{
+				wchar_t ch = str[i];
+				if (!(ch == L'.' || L'0' <= ch && ch <= L'9'))
+					break;
+			}
+
+			std::wstring num_str = str.substr(pos, i - pos);
+			pos = i;
+
+			if (num_str.empty() || num_str == L".")
+				return Duration();
+
+			for (; i < len; ++i)
+			{
+				wchar_t ch = str[i];
+				if (ch == L'.' || L'0' <= ch && ch <= L'9')
+					break;
+			}
+
+			std::wstring unit_str = str.substr(pos, i - pos);
+			pos = i;
+
+			auto iter = unit_map.find(unit_str);
+			if (iter == unit_map.end())
+				return Duration();
+
+			d += iter->second * std::stod(num_str);
+		}
+
+		if (negative)
+			d = -d;
+		return d;
+	}
+
+	inline void Run()
+	{
+		const std::wstring inputs[] = { L"300ms", L"-1.5h", L"2h45m", L"1.25s", L"+3m10.5s" };
+		const int count = sizeof(inputs) / sizeof(inputs[0]);
+		const int rounds = 20000;
+
+		// both parsers must agree before their speed is compared
+		for (int i = 0; i < count; ++i)
+		{
+			if (RegexParseDuration(inputs[i]) != time::ParseDuration(inputs[i]))
+				std::printf("  mismatch on input %d\n", i);
+		}
+
+		long long sink = 0;
+
+		Stopwatch watch;
+		for (int r = 0; r < rounds; ++r)
+			for (int i = 0; i < count; ++i)
+				sink += RegexParseDuration(inputs[i]).Microseconds();
+		const double regex_ns = watch.Elapsed() * 1000.0 / (rounds * count);
+
+		watch.Restart();
+		for (int r = 0; r < rounds; ++r)
+			for (int i = 0; i < count; ++i)
+				sink += time::ParseDuration(inputs[i]).Microseconds();
+		const double string_ns = watch.Elapsed() * 1000.0 / (rounds * count);
+
+		watch.Restart();
+		for (int r = 0; r < rounds; ++r)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				Duration d;
+				time::ParseDuration(inputs[i].c_str(), inputs[i].length(), d);
+				sink += d.Microseconds();
+			}
+		}
+		const double raw_ns = watch.Elapsed() * 1000.0 / (rounds * count);
+
+		std::printf("ParseDuration, %d inputs x %d rounds (checksum %lld)\n", count, rounds, sink);
+		Report("regex parser", regex_ns, "ns/call");
+		Report("ParseDuration(std::wstring)", string_ns, "ns/call");
+		Report("ParseDuration(const wchar_t*, size_t)", raw_ns, "ns/call");
+	}
+}
@@ -0,0 +1,159 @@
+// Copyright (C) 2019 Nomango
+
+#pragma once
+#include "common.h"
+
+// 
+// Աָ (IntrusiveList<SmartPtr>) ָ (IntrusiveRawList) ı,
+// Ȼ޴ģʽͬģĽڵÿ֡ĸºȾʱ
+namespace TraversalBench
+{
+	const int PARENTS = 100;
+	const int CHILDREN = 1000;
+
+	// ɵӷʽ: ǰָ붼ָ, ÿһҪ Retain/Release
+	struct SmartItem;
+	using SmartItemPtr = SmartPtr<SmartItem>;
+
+	struct SmartItem
+		: public RefCounter
+		, public IntrusiveListItem<SmartItemPtr>
+	{
+		long long value = 0;
+		IntrusiveList<SmartItemPtr> children;
+	};
+
+	// µӷʽ: ָ, ÿԪصһ
+	struct RawItem
+		: public RefCounter
+		, public IntrusiveRawListItem<RawItem>
+	{
+		long long value = 0;
+		IntrusiveRawList<RawItem> children;
+	};
+
+	inline void WalkSmart(SmartItemPtr const& root)
+	{
+		for (SmartItemPtr parent = root->children.First(); parent; parent = parent->NextItem())
+		{
+			for (SmartItemPtr child = parent->children.First(); child; child = child->NextItem())
+			{
+				child->value++;
+			}
+		}
+	}
+
+	inline void WalkRaw(RawItem* root)
+	{
+		// the same safe iterator as Node::Update
+		for (IntrusiveRawList<RawItem>::Iterator parent(root->children); parent; parent.Next())
+		{
+			for (IntrusiveRawList<RawItem>::Iterator child(parent.Get()->children); child; child.Next())
+			{
+				child.Get()->value++;
+			}
+		}
+	}
+
+	inline void RunLists(int rounds)
+	{
+		SmartItemPtr smart_root = new SmartItem;
+		RawItem* raw_root = new RawItem;
+		raw_root->Retain();
+
+		for (int i = 0; i < PARENTS; ++i)
+		{
+			SmartItemPtr smart_parent = new SmartItem;
+			RawItem* raw_parent = new RawItem;
+
+			for (int j = 0; j < CHILDREN; ++j)
+			{
+				smart_parent->children.PushBack(new SmartItem);
+				raw_parent->children.PushBack(new RawItem);
+			}
+
+			smart_root->children.PushBack(smart_parent);
+			raw_root->children.PushBack(raw_parent);
+		}
+
+		WalkSmart(smart_root);
+		WalkRaw(raw_root);
+
+		Stopwatch watch;
+		for (int i = 0; i < rounds; ++i)
+			WalkSmart(smart_root);
+		const double smart_ms = watch.Elapsed() / 1000.0 / rounds;
+
+		watch.Restart();
+		for (int i = 0; i < rounds; ++i)
+			WalkRaw(raw_root);
+		const double raw_ms = watch.Elapsed() / 1000.0 / rounds;
+
+		Report("smart-pointer links", smart_ms, "ms/traversal");
+		Report("raw links", raw_ms, "ms/traversal");
+
+		for (SmartItemPtr parent = smart_root->children.First(); parent; parent = parent->NextItem())
+			parent->children.Clear();
+		smart_root->children.Clear();
+		raw_root->Release();
+	}
+
+	// ÿ֡תľ, ֤ڵ㲻״̬
+	class SpinSprite
+		: public Sprite
+	{
+	public:
+		explicit SpinSprite(ImagePtr const& image)
+		{
+			Load(image);
+			SetSize(8.f, 8.f);
+		}
+
+		void OnUpdate(Duration dt) override
+		{
+			SetRotation(GetRotation() + dt.Seconds() * 90.f);
+		}
+	};
+
+	// еĽڵ, ÿ֡²Ⱦȫڵ
+	class TreeScene
+		: public Scene
+	{
+	public:
+		TreeScene()
+		{
+			// ޴ģʽûλͼͼƬҲᱻ¼ɻ, һͼƬԱ
+			ImagePtr image = new Image;
+
+			for (int i = 0; i < PARENTS; ++i)
+			{
+				NodePtr parent = new Node;
+				for (int j = 0; j < CHILDREN; ++j)
+				{
+					// ȫ 640x480 ӿ, ᱻü
+					NodePtr child = new SpinSprite(image);
+					child->SetPosition(j * 0.6f, i * 4.6f);
+					parent->AddChild(child);
+				}
+				AddChild(parent);
+			}
+		}
+	};
+
+	inline void RunScene(Application& app, int frames)
+	{
+		app.EnterScene(new TreeScene);
+		app.RunFrames(2, 16);
+
+		Stopwatch watch;
+		app.RunFrames(frames, 16);
+		Report("Node tree update + render (headless)", watch.Elapsed() / 1000.0 / frames, "ms/frame");
+	}
+
+	inline void Run(Application& app)
+	{
+		std::printf("Tree traversal, %d x %d nodes\n", PARENTS, CHILDREN);
+		RunLists(50);
+		RunScene(app, 50);
+	}
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2019 Nomango
+
+#pragma once
+#include "common.h"
+#include <cmath>
+
+// ϵͳ
+// 5 λƶɳĲϵͳ,  TweenSystem::Step ÿ䶯ĺʱ,
+// Աֻ: Զ庯 (std::function),  (switch) Ͳұ
+namespace TweenBench
+{
+	const int TWEENS = 50000;
+	const int FRAMES = 100;
+
+	class TweenScene
+		: public Scene
+	{
+	public:
+		TweenScene(EaseFunc const* eases, int ease_count, Array<ActionTween*>& tweens)
+		{
+			tweens.reserve(TWEENS);
+			for (int i = 0; i < TWEENS; ++i)
+			{
+				ActionTween* tween = new ActionMoveBy(1000, Point(100.f, 50.f), eases[i % ease_count]);
+				tween->SetLoops(-1);
+				tweens.push_back(tween);
+
+				NodePtr node = new Node;
+				node->AddAction(tween);
+				AddChild(node);
+			}
+		}
+	};
+
+	// ÿ䶯ÿθµ
+	inline double Measure(Application& app, EaseFunc const* eases, int ease_count)
+	{
+		Array<ActionTween*> tweens;
+		SmartPtr<TweenScene> scene = new TweenScene(eases, ease_count, tweens);
+
+		// start the actions, they are handed to the tween system once they are running
+		app.EnterScene(scene);
+		app.RunFrames(3, 16);
+
+		TweenSystem& system = scene->GetTweenSystem();
+		if (system.GetCount() != TWEENS)
+			std::printf("  only %d of %d tweens are batched\n", system.GetCount(), TWEENS);
+
+		long long total = 0;
+		for (int i = 0; i < FRAMES; ++i)
+		{
+			// the action managers mark their tweens while the nodes update
+			for (auto tween : tweens)
+				system.MarkActive(tween);
+
+			Stopwatch watch;
+			system.Step(16);
+			total += watch.Elapsed();
+		}
+		return total * 1000.0 / (static_cast<double>(FRAMES) * TWEENS);
+	}
+
+	// ұԭߵ
+	inline float MaxTableError(EaseFunc const& ease)
+	{
+		EaseFunc table = ease.ToTable();
+
+		float error = 0.f;
+		for (int i = 0; i <= 10000; ++i)
+		{
+			float step = i / 10000.f;
+			error = std::max(error, std::abs(table(step) - ease(step)));
+		}
+		return error;
+	}
+
+	inline void Run(Application& app)
+	{
+		using std::placeholders::_1;
+
+		std::printf("TweenSystem::Step, %d position tweens\n", TWEENS);
+
+		{
+			// std::function objects, as EaseFunc stored every curve before
+			EaseFunc custom[] = {
+				std::function<float(float)>(math::EaseQuadIn),
+				std::function<float(float)>(math::EaseQuadOut),
+				std::function<float(float)>(math::EaseCubicInOut),
+				std::function<float(float)>(math::EaseBackOut),
+				std::function<float(float)>(std::bind(math::EaseInOut, _1, 2.f)),
+				std::function<float(float)>(math::EaseQuartOut),
+				std::function<float(float)>(math::Linear),
+				std::function<float(float)>(math::EaseQuintIn),
+			};
+			EaseFunc builtin[] = {
+				Ease::QuadIn, Ease::QuadOut, Ease::CubicInOut, Ease::BackOut,
+				MakeEaseInOut(2.f), Ease::QuartOut, Ease::Linear, Ease::QuintIn,
+			};
+
+			Report("polynomial, std::function", Measure(app, custom, 8), "ns/tween");
+			Report("polynomial, switch", Measure(app, builtin, 8), "ns/tween");
+		}
+
+		{
+			EaseFunc custom[] = {
+				std::function<float(float)>(std::bind(math::EaseElasticOut, _1, 0.3f)),
+				std::function<float(float)>(math::EaseBounceOut),
+				std::function<float(float)>(math::EaseExponentialInOut),
+				std::function<float(float)>(std::bind(math::EaseElasticIn, _1, 0.3f)),
+				std::function<float(float)>(math::EaseBounceInOut),
+				std::function<float(float)>(math::EaseExponentialIn),
+				std::function<float(float)>(math::EaseSineInOut),
+				std::function<float(float)>(std::bind(math::EaseElasticInOut, _1, 0.3f)),
+			};
+			EaseFunc builtin[] = {
+				MakeEaseElasticOut(0.3f), Ease::BounceOut, Ease::ExpoInOut, MakeEaseElasticIn(0.3f),
+				Ease::BounceInOut, Ease::ExpoIn, Ease::SineInOut, MakeEaseElasticInOut(0.3f),
+			};
+
+			EaseFunc tables[8];
+			for (int i = 0; i < 8; ++i)
+				tables[i] = builtin[i].ToTable();
+
+			Report("elastic/bounce/expo, std::function", Measure(app, custom, 8), "ns/tween");
+			Report("elastic/bounce/expo, switch", Measure(app, builtin, 8), "ns/tween");
+			Report("elastic/bounce/expo, tables", Measure(app, tables, 8), "ns/tween");
+
+			float error = 0.f;
+			for (auto const& ease : builtin)
+				error = std::max(error, MaxTableError(ease));
+			Report("max table error (256 samples)", error, "");
+		}
+	}
+}
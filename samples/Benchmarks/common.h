@@ -0,0 +1,28 @@
+// Copyright (C) 2019 Nomango
+
+#pragma once
+#include "easy2d.h"
+#include <cstdio>
+
+using namespace easy2d;
+
+// ʱ, ʹĸ߾ʱ
+class Stopwatch
+{
+public:
+	Stopwatch() : start_(time::Now()) {}
+
+	void Restart() { start_ = time::Now(); }
+
+	// ΢
+	long long Elapsed() const { return (time::Now() - start_).Microseconds(); }
+
+private:
+	time::TimePoint start_;
+};
+
+// ӡһн
+inline void Report(const char* name, double value, const char* unit)
+{
+	std::printf("  %-40s %10.2f %s\n", name, value, unit);
+}
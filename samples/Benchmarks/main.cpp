@@ -0,0 +1,29 @@
+// Copyright (C) 2019 Nomango
+
+#include "TraversalBench.h"
+#include "DurationBench.h"
+#include "TweenBench.h"
+
+// ܲ
+// ʹ޴ģʽ, ̨, ʹ Release ñ
+int main()
+{
+	try
+	{
+		Application app;
+
+		Options options;
+		options.headless = true;
+		app.Init(options);
+
+		TraversalBench::Run(app);
+		DurationBench::Run();
+		TweenBench::Run(app);
+	}
+	catch (std::exception& e)
+	{
+		std::printf("An exception has occurred: %s\n", e.what());
+		return 1;
+	}
+	return 0;
+}